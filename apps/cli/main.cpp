@@ -1,22 +1,34 @@
 #include "coronan/corona-api_client.hpp"
+#include "coronan/iso_date.hpp"
 
 #include <cstdlib>
-#include <fmt/core.h>
+#include <fmt/format.h>
+#include <iterator>
 #include <lyra/lyra.hpp>
 #include <sstream>
 
 namespace {
-std::string parse_commandline_arguments(lyra::args const& args);
+struct CommandLineOptions
+{
+  std::string country_code{};
+  std::string cache_directory{};
+  std::string api_url{};
+  std::string record_file{};
+  std::string replay_file{};
+};
+
+CommandLineOptions parse_commandline_arguments(lyra::args const& args);
+coronan::CountryData request_country_data(CommandLineOptions const& options);
 void print_data(coronan::CountryData const& country_data);
 } // namespace
 
 int main(int argc, char* argv[])
 {
-  std::string const country_code = parse_commandline_arguments({argc, argv});
+  auto const options = parse_commandline_arguments({argc, argv});
 
   try
   {
-    auto const country_data = coronan::CoronaAPIClient{}.request_country_data(country_code);
+    auto const country_data = request_country_data(options);
     print_data(country_data);
   }
   catch (coronan::SSLException const& ex)
@@ -38,12 +50,17 @@ int main(int argc, char* argv[])
 }
 
 namespace {
-std::string parse_commandline_arguments(lyra::args const& args)
+CommandLineOptions parse_commandline_arguments(lyra::args const& args)
 {
-  std::string country = "ch";
+  CommandLineOptions options{"ch", coronan::DiskCache::default_directory(), coronan::corona_api_url};
   bool help_request = false;
   auto command_line_parser =
-      lyra::cli_parser() | lyra::help(help_request) | lyra::opt(country, "country")["-c"]["--country"]("Country Code");
+      lyra::cli_parser() | lyra::help(help_request) |
+      lyra::opt(options.country_code, "country")["-c"]["--country"]("Country Code") |
+      lyra::opt(options.cache_directory, "directory")["--cache-dir"]("Directory of the response cache") |
+      lyra::opt(options.api_url, "url")["--api-url"]("Base url (https) of the corona-api") |
+      lyra::opt(options.record_file, "file")["--record"]("Record the http responses to an archive file") |
+      lyra::opt(options.replay_file, "file")["--replay"]("Replay the http responses of an archive file (offline)");
 
   std::stringstream usage;
   usage << command_line_parser;
@@ -60,21 +77,63 @@ std::string parse_commandline_arguments(lyra::args const& args)
     fmt::print("{}\n", usage.str());
     std::exit(EXIT_SUCCESS);
   }
-  return country;
+  return options;
 }
 
-void print_data(coronan::CountryData const& country_data)
+coronan::CountryData request_country_data(CommandLineOptions const& options)
 {
+  using ArchiveClient = coronan::CoronaAPIClientType<coronan::ArchiveHTTPClient>;
+  if (!options.replay_file.empty())
+  {
+    coronan::ArchiveHTTPClient::archive().load(options.replay_file);
+    coronan::ArchiveHTTPClient::set_mode(coronan::ArchiveMode::replay);
+    return ArchiveClient{options.api_url}.request_country_data(options.country_code);
+  }
+  if (!options.record_file.empty())
+  {
+    coronan::ArchiveHTTPClient::set_mode(coronan::ArchiveMode::record);
+    auto country_data = ArchiveClient{options.api_url}.request_country_data(options.country_code);
+    coronan::ArchiveHTTPClient::archive().save(options.record_file);
+    return country_data;
+  }
+  auto const cache_policy = coronan::DiskCachePolicy<>{coronan::DiskCacheConfig{options.cache_directory}};
+  return coronan::DiskCachedCoronaAPIClient{options.api_url, cache_policy}.request_country_data(options.country_code);
+}
 
-  constexpr auto optional_to_string = [](auto const& value) {
-    return value.has_value() ? std::to_string(value.value()) : "--";
+void print_data(coronan::CountryData const& country_data)
+{
+  // The rows are formatted into a single buffer, i.e. without a temporary string per value
+  fmt::memory_buffer output;
+  auto const format_optional = [&output](auto const& value) {
+    if (value.has_value())
+    {
+      fmt::format_to(std::back_inserter(output), "{}", value.value());
+    }
+    else
+    {
+      fmt::format_to(std::back_inserter(output), "--");
+    }
   };
-  fmt::print("datetime, confirmed, death, recovered, active\n");
+  fmt::format_to(std::back_inserter(output), "datetime, confirmed, death, recovered, active\n");
   for (auto const& data_point : country_data.timeline)
   {
-    fmt::print("{}, {}, {}, {}, {}\n", data_point.date, optional_to_string(data_point.confirmed),
-               optional_to_string(data_point.deaths), optional_to_string(data_point.recovered),
-               optional_to_string(data_point.active));
+    if (data_point.date.has_value())
+    {
+      auto const [date, hour, minute, second] = coronan::iso_date::civil_from_seconds(data_point.date.value());
+      fmt::format_to(std::back_inserter(output), "{:04}-{:02}-{:02}T{:02}:{:02}:{:02}Z", date.year, date.month,
+                     date.day, hour, minute, second);
+    }
+    else
+    {
+      fmt::format_to(std::back_inserter(output), "--");
+    }
+    for (auto const* value : {&data_point.confirmed, &data_point.deaths, &data_point.recovered, &data_point.active})
+    {
+      fmt::format_to(std::back_inserter(output), ", ");
+      format_optional(*value);
+    }
+    fmt::format_to(std::back_inserter(output), "\n");
   }
+  fmt::print("{}", fmt::string_view{output.data(), output.size()});
 }
 } // namespace
@@ -0,0 +1,53 @@
+#include "country_chart_series.hpp"
+
+#include <algorithm>
+#include <limits>
+#include <optional>
+
+namespace coronan_ui {
+
+CountryChartSeries create_chart_series(coronan::CountryData const& country_data)
+{
+  CountryChartSeries chart_series{};
+  auto const point_count = static_cast<int>(country_data.timeline.size());
+  chart_series.deaths.reserve(point_count);
+  chart_series.confirmed.reserve(point_count);
+  chart_series.active.reserve(point_count);
+  chart_series.recovered.reserve(point_count);
+
+  auto const append = [&chart_series](QVector<QPointF>& series, qreal date, std::optional<uint32_t> const& cases) {
+    if (cases.has_value())
+    {
+      auto const value = static_cast<qreal>(cases.value());
+      series.append(QPointF{date, value});
+      chart_series.max_cases = std::max(chart_series.max_cases, value);
+    }
+  };
+
+  auto first_date = std::numeric_limits<qint64>::max();
+  auto last_date = std::numeric_limits<qint64>::min();
+  for (auto const& data_point : country_data.timeline)
+  {
+    if (!data_point.date.has_value())
+    {
+      continue;
+    }
+    constexpr auto milliseconds_per_second = 1000;
+    auto const date_msecs = static_cast<qint64>(data_point.date.value() * milliseconds_per_second);
+    first_date = std::min(first_date, date_msecs);
+    last_date = std::max(last_date, date_msecs);
+    auto const date = static_cast<qreal>(date_msecs);
+    append(chart_series.deaths, date, data_point.deaths);
+    append(chart_series.confirmed, date, data_point.confirmed);
+    append(chart_series.active, date, data_point.active);
+    append(chart_series.recovered, date, data_point.recovered);
+  }
+  if (first_date <= last_date)
+  {
+    chart_series.first_date = first_date;
+    chart_series.last_date = last_date;
+  }
+  return chart_series;
+}
+
+} // namespace coronan_ui
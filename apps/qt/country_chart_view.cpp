@@ -1,13 +1,12 @@
 #include "country_chart_view.hpp"
 
-#include "coronan/corona-api_parser.hpp"
-#include "country_data_model.hpp"
+#include "coronan/corona-api_datatypes.hpp"
+#include "country_chart_series.hpp"
 
 #include <QDateTime>
 #include <QLatin1String>
 #include <QString>
 #include <QtCharts/QDateTimeAxis>
-#include <QtCharts/QLineSeries>
 #include <QtCharts/QValueAxis>
 
 namespace {
@@ -18,11 +17,10 @@ constexpr auto create_datetime_axis = []() {
   return x_axis;
 };
 
-constexpr auto create_value_axis = [](qreal max) {
+constexpr auto create_value_axis = []() {
   auto* const y_axis = new QtCharts::QValueAxis{};
   y_axis->setTitleText(QStringLiteral("Cases"));
   y_axis->setLabelFormat(QStringLiteral("%i  "));
-  y_axis->setRange(0, max);
   return y_axis;
 };
 
@@ -34,12 +32,11 @@ constexpr auto create_chart_title = [](auto const& country_name) {
 
 namespace coronan_ui {
 
-CountryChartView::CountryChartView(CountryDataModel* const data_model, QWidget* parent) : QChartView(parent)
+CountryChartView::CountryChartView(QWidget* parent) : QChartView(parent)
 {
   auto* const chart = new QChart{};
-  chart->setTitle(create_chart_title(data_model->country()));
   auto* const x_axis = create_datetime_axis();
-  auto* const y_axis = create_value_axis(data_model->cases_confirmed());
+  auto* const y_axis = create_value_axis();
 
   chart->addAxis(x_axis, Qt::AlignBottom);
   chart->addAxis(y_axis, Qt::AlignLeft);
@@ -47,33 +44,38 @@ CountryChartView::CountryChartView(CountryDataModel* const data_model, QWidget*
   chart->legend()->setAlignment(Qt::AlignTop);
   chart->legend()->show();
 
-  const auto create_series = [&](int column_index) {
+  const auto create_series = [&](QString const& name) {
     auto* const series = new QLineSeries{};
-    series->setName(data_model->headerData(column_index).toString());
-
-    auto& model_mapper = model_mappers.at(static_cast<size_t>(column_index - 1));
-    model_mapper.setXColumn(CountryDataModel::date_column_index);
-    model_mapper.setYColumn(column_index);
-    model_mapper.setSeries(series);
-    model_mapper.setModel(data_model);
+    series->setName(name);
     chart->addSeries(series);
     series->attachAxis(x_axis);
     series->attachAxis(y_axis);
+    return series;
   };
 
-  create_series(CountryDataModel::deaths_column_index);
-  create_series(CountryDataModel::confirmed_column_index);
-  create_series(CountryDataModel::active_column_index);
-  create_series(CountryDataModel::recovered_column_index);
+  deaths_series = create_series(QStringLiteral("Death"));
+  confirmed_series = create_series(QStringLiteral("Confirmed"));
+  active_series = create_series(QStringLiteral("Active"));
+  recovered_series = create_series(QStringLiteral("Recovered"));
 
   this->setChart(chart);
   this->setRenderHint(QPainter::Antialiasing, true);
 }
 
-void CountryChartView::update_ui(CountryDataModel const& data_model)
+void CountryChartView::update_ui(coronan::CountryData const& country_data)
 {
-  this->chart()->setTitle(create_chart_title(data_model.country()));
-  this->chart()->axes(Qt::Vertical).at(0)->setMax(data_model.cases_confirmed());
+  auto const chart_series = create_chart_series(country_data);
+
+  this->chart()->setTitle(create_chart_title(QString::fromStdString(country_data.info.name)));
+  // replace() emits a single pointsReplaced() per series instead of a signal per point
+  deaths_series->replace(chart_series.deaths);
+  confirmed_series->replace(chart_series.confirmed);
+  active_series->replace(chart_series.active);
+  recovered_series->replace(chart_series.recovered);
+
+  this->chart()->axes(Qt::Vertical).at(0)->setRange(0, chart_series.max_cases);
+  this->chart()->axes(Qt::Horizontal).at(0)->setRange(QDateTime::fromMSecsSinceEpoch(chart_series.first_date, Qt::UTC),
+                                                       QDateTime::fromMSecsSinceEpoch(chart_series.last_date, Qt::UTC));
 }
 
 } // namespace coronan_ui
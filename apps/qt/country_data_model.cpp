@@ -1,100 +1,213 @@
 #include "country_data_model.hpp"
 
+#include <QLatin1String>
+#include <QString>
+#include <optional>
+#include <utility>
+
+namespace coronan_ui {
+
 namespace {
-constexpr auto columns = 5;
+constexpr std::array<char const*, CountryDataModel::column_count> column_titles{"Date", "Death", "Confirmed", "Active",
+                                                                                 "Recovered"};
+
+constexpr auto column_bit = [](int column) { return static_cast<uint8_t>(1U << static_cast<unsigned>(column)); };
+} // namespace
+
+int CountryDataModel::TimelineColumns::size() const noexcept
+{
+  return static_cast<int>(dates.size());
 }
 
-namespace coronan_ui {
+void CountryDataModel::TimelineColumns::reserve(std::size_t row_count)
+{
+  dates.reserve(row_count);
+  for (auto& column : cases)
+  {
+    column.reserve(row_count);
+  }
+  valid_columns.reserve(row_count);
+}
 
-CountryDataModel::CountryDataModel(QObject* parent) : QAbstractTableModel(parent)
+void CountryDataModel::TimelineColumns::append(coronan::CountryData::TimelineData const& data_point)
 {
+  uint8_t valid = 0;
+  auto const mark_valid = [&valid](int column) { valid = static_cast<uint8_t>(valid | column_bit(column)); };
+  if (data_point.date.has_value())
+  {
+    mark_valid(date_column_index);
+  }
+  dates.push_back(data_point.date.value_or(0));
+  auto const append_cases = [this, &mark_valid](int column, std::optional<uint32_t> const& value) {
+    cases[static_cast<std::size_t>(column - 1)].push_back(value.value_or(0));
+    if (value.has_value())
+    {
+      mark_valid(column);
+    }
+  };
+  append_cases(deaths_column_index, data_point.deaths);
+  append_cases(confirmed_column_index, data_point.confirmed);
+  append_cases(active_column_index, data_point.active);
+  append_cases(recovered_column_index, data_point.recovered);
+  valid_columns.push_back(valid);
 }
 
-void CountryDataModel::populate_data(coronan::CountryData const& country_data)
+bool CountryDataModel::TimelineColumns::is_valid(int row, int column) const noexcept
 {
-  beginResetModel();
-  country_name = QString::fromStdString(country_data.info.name);
-  confirmed_cases = country_data.latest.confirmed.value_or(0);
-  country_timeline_data.clear();
+  return (valid_columns[static_cast<std::size_t>(row)] & column_bit(column)) != 0;
+}
 
-  for (auto const& data_point : country_data.timeline)
+bool CountryDataModel::TimelineColumns::same_date(int row, TimelineColumns const& other, int other_row) const noexcept
+{
+  auto const valid = is_valid(row, date_column_index);
+  return valid == other.is_valid(other_row, date_column_index) &&
+         (!valid || dates[static_cast<std::size_t>(row)] == other.dates[static_cast<std::size_t>(other_row)]);
+}
+
+bool CountryDataModel::TimelineColumns::same_row(int row, TimelineColumns const& other, int other_row) const noexcept
+{
+  if (valid_columns[static_cast<std::size_t>(row)] != other.valid_columns[static_cast<std::size_t>(other_row)] ||
+      !same_date(row, other, other_row))
   {
-    CountryTimelineData timeline_data;
-    timeline_data.date = QDateTime::fromString(data_point.date.c_str(), QStringLiteral("yyyy-MM-ddThh:mm:ss.zZ"));
-    timeline_data.deaths = data_point.deaths.has_value() ? QVariant{data_point.deaths.value()} : QVariant{};
-    timeline_data.confirmed_cases =
-        data_point.confirmed.has_value() ? QVariant{data_point.confirmed.value()} : QVariant{};
-    timeline_data.active_cases = data_point.active.has_value() ? QVariant{data_point.active.value()} : QVariant{};
-    timeline_data.recovered_cases =
-        data_point.recovered.has_value() ? QVariant{data_point.recovered.value()} : QVariant{};
-    country_timeline_data.push_back(timeline_data);
+    return false;
   }
-  endResetModel();
+  for (std::size_t column = 0; column < cases.size(); ++column)
+  {
+    if (cases[column][static_cast<std::size_t>(row)] != other.cases[column][static_cast<std::size_t>(other_row)])
+    {
+      return false;
+    }
+  }
+  return true;
 }
 
-int CountryDataModel::rowCount(const QModelIndex&) const
+QVariant CountryDataModel::date_cell(TimelineColumns const& timeline, int row)
 {
-  return country_timeline_data.length();
+  return timeline.is_valid(row, date_column_index)
+             ? QDateTime::fromSecsSinceEpoch(timeline.dates[static_cast<std::size_t>(row)], Qt::UTC)
+             : QDateTime{};
 }
 
-int CountryDataModel::columnCount(const QModelIndex&) const
+template <int Column>
+QVariant CountryDataModel::cases_cell(TimelineColumns const& timeline, int row)
 {
-  return columns;
+  return timeline.is_valid(row, Column)
+             ? QVariant{timeline.cases[static_cast<std::size_t>(Column - 1)][static_cast<std::size_t>(row)]}
+             : QVariant{};
 }
 
-QVariant CountryDataModel::data(const QModelIndex& index, int role) const
+CountryDataModel::CountryDataModel(QObject* parent) : QAbstractTableModel(parent)
+{
+}
+
+void CountryDataModel::populate_data(coronan::CountryData const& country_data)
 {
-  if (!index.isValid() || role != Qt::DisplayRole)
+  TimelineColumns new_timeline{};
+  new_timeline.reserve(country_data.timeline.size());
+  for (auto const& data_point : country_data.timeline)
   {
-    return QVariant();
+    new_timeline.append(data_point);
+  }
+  confirmed_cases = country_data.latest.confirmed.value_or(0);
+
+  auto const new_country_name = QString::fromStdString(country_data.info.name);
+  auto const old_row_count = timeline.size();
+  auto const new_row_count = new_timeline.size();
+  if (new_country_name == country_name && old_row_count > 0 && new_row_count >= old_row_count)
+  {
+    auto const dates_match = [this, &new_timeline, old_row_count](int row_offset) {
+      for (int row = 0; row < old_row_count; ++row)
+      {
+        if (!timeline.same_date(row, new_timeline, row + row_offset))
+        {
+          return false;
+        }
+      }
+      return true;
+    };
+    auto const inserted_row_count = new_row_count - old_row_count;
+    // The corona-api lists the latest day first, i.e. new days are usually inserted at the front
+    if (dates_match(inserted_row_count))
+    {
+      insert_rows(std::move(new_timeline), 0, inserted_row_count);
+      return;
+    }
+    if (dates_match(0))
+    {
+      insert_rows(std::move(new_timeline), old_row_count, inserted_row_count);
+      return;
+    }
   }
-  if (index.column() == date_column_index)
+
+  beginResetModel();
+  country_name = new_country_name;
+  timeline = std::move(new_timeline);
+  endResetModel();
+}
+
+void CountryDataModel::insert_rows(TimelineColumns new_timeline, int first_inserted_row, int inserted_row_count)
+{
+  // The model must still return the old rows until beginInsertRows returned, i.e. the timelines are swapped after it
+  TimelineColumns old_timeline{};
+  if (inserted_row_count > 0)
   {
-    return country_timeline_data.at(index.row()).date;
+    beginInsertRows(QModelIndex{}, first_inserted_row, first_inserted_row + inserted_row_count - 1);
+    old_timeline = std::exchange(timeline, std::move(new_timeline));
+    endInsertRows();
   }
-  else if (index.column() == deaths_column_index)
+  else
   {
-    return country_timeline_data.at(index.row()).deaths;
+    old_timeline = std::exchange(timeline, std::move(new_timeline));
   }
-  else if (index.column() == confirmed_column_index)
+
+  // The values of the previous days may have been updated too (e.g. the day in progress)
+  auto const row_offset = first_inserted_row == 0 ? inserted_row_count : 0;
+  auto first_changed_row = -1;
+  auto last_changed_row = -1;
+  for (int row = 0; row < old_timeline.size(); ++row)
   {
-    return country_timeline_data.at(index.row()).confirmed_cases;
+    if (!old_timeline.same_row(row, timeline, row + row_offset))
+    {
+      first_changed_row = first_changed_row == -1 ? row + row_offset : first_changed_row;
+      last_changed_row = row + row_offset;
+    }
   }
-  else if (index.column() == active_column_index)
+  if (first_changed_row != -1)
   {
-    return country_timeline_data.at(index.row()).active_cases;
+    Q_EMIT dataChanged(index(first_changed_row, 0), index(last_changed_row, column_count - 1), {Qt::DisplayRole});
   }
-  else if (index.column() == recovered_column_index)
+}
+
+int CountryDataModel::rowCount(const QModelIndex&) const
+{
+  return timeline.size();
+}
+
+int CountryDataModel::columnCount(const QModelIndex&) const
+{
+  return column_count;
+}
+
+QVariant CountryDataModel::data(const QModelIndex& index, int role) const
+{
+  using CellAccessor = QVariant (*)(TimelineColumns const&, int);
+  static constexpr std::array<CellAccessor, column_count> cell_accessors{
+      &date_cell, &cases_cell<deaths_column_index>, &cases_cell<confirmed_column_index>,
+      &cases_cell<active_column_index>, &cases_cell<recovered_column_index>};
+
+  if (!index.isValid() || role != Qt::DisplayRole || index.column() < 0 || index.column() >= column_count ||
+      index.row() >= timeline.size())
   {
-    return country_timeline_data.at(index.row()).recovered_cases;
+    return QVariant();
   }
-  return QVariant();
+  return cell_accessors[static_cast<std::size_t>(index.column())](timeline, index.row());
 }
 
 QVariant CountryDataModel::headerData(int section, Qt::Orientation orientation, int role) const
 {
-  if (role == Qt::DisplayRole && orientation == Qt::Horizontal)
+  if (role == Qt::DisplayRole && orientation == Qt::Horizontal && section >= 0 && section < column_count)
   {
-    if (section == date_column_index)
-    {
-      return QStringLiteral("Date");
-    }
-    else if (section == deaths_column_index)
-    {
-      return QStringLiteral("Death");
-    }
-    else if (section == confirmed_column_index)
-    {
-      return QStringLiteral("Confirmed");
-    }
-    else if (section == active_column_index)
-    {
-      return QStringLiteral("Active");
-    }
-    else if (section == recovered_column_index)
-    {
-      return QStringLiteral("Recovered");
-    }
+    return QString{QLatin1String{column_titles[static_cast<std::size_t>(section)]}};
   }
   return QVariant();
 }
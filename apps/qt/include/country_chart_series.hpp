@@ -0,0 +1,32 @@
+#pragma once
+
+#include "coronan/corona-api_datatypes.hpp"
+
+#include <QPointF>
+#include <QVector>
+#include <QtGlobal>
+
+namespace coronan_ui {
+
+/**
+ * The line series of the CountryChartView (x: milliseconds since epoch, y: cases) together with their axis ranges,
+ * built directly from the timeline of a country.
+ */
+struct CountryChartSeries
+{
+  QVector<QPointF> deaths{};    /**< number of deaths */
+  QVector<QPointF> confirmed{}; /**< number of confirmed cases */
+  QVector<QPointF> active{};    /**< number of active cases */
+  QVector<QPointF> recovered{}; /**< number of recovered cases */
+  qreal max_cases{};            /**< maximum number of cases of all series (0 if they are empty) */
+  qint64 first_date{};          /**< earliest date of the series (milliseconds since epoch) */
+  qint64 last_date{};           /**< latest date of the series (milliseconds since epoch) */
+};
+
+/**
+ * Build the chart series of a country in a single pass over its timeline. Timeline points without date are skipped,
+ * as are missing values of a series.
+ */
+CountryChartSeries create_chart_series(coronan::CountryData const& country_data);
+
+} // namespace coronan_ui
@@ -1,15 +1,11 @@
 #pragma once
 
-#include <QVXYModelMapper>
-#include <QtCharts/QChartView>
-#include <vector>
+#include "coronan/corona-api_datatypes.hpp"
 
-namespace coronan {
-struct CountryData;
-}
+#include <QtCharts/QChartView>
+#include <QtCharts/QLineSeries>
 
 namespace coronan_ui {
-class CountryDataModel;
 
 QT_CHARTS_USE_NAMESPACE
 
@@ -17,12 +13,18 @@ class CountryChartView : public QChartView
 {
   Q_OBJECT
 public:
-  explicit CountryChartView(CountryDataModel* const data_model, QWidget* parent = nullptr);
+  explicit CountryChartView(QWidget* parent = nullptr);
 
-  void update_ui(CountryDataModel const& data_model);
+  /**
+   * Replace the series of the chart by the timeline of country_data, i.e. every series is updated once
+   */
+  void update_ui(coronan::CountryData const& country_data);
 
 private:
-  std::vector<QVXYModelMapper> model_mappers{4};
+  QLineSeries* deaths_series = nullptr;
+  QLineSeries* confirmed_series = nullptr;
+  QLineSeries* active_series = nullptr;
+  QLineSeries* recovered_series = nullptr;
 };
 
 } // namespace coronan_ui
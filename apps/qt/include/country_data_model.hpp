@@ -4,8 +4,10 @@
 
 #include <QAbstractTableModel>
 #include <QDateTime>
-#include <QList>
 #include <QVariant>
+#include <array>
+#include <cstdint>
+#include <vector>
 
 namespace coronan_ui {
 
@@ -15,6 +17,10 @@ class CountryDataModel : public QAbstractTableModel
 public:
   explicit CountryDataModel(QObject* parent = nullptr);
 
+  /**
+   * Show the data of a country. If the timeline of the shown country only gained new days (at the front or the end)
+   * the new rows are inserted and changed rows are updated, otherwise the model is reset.
+   */
   void populate_data(coronan::CountryData const& country_data);
 
   int rowCount(const QModelIndex& parent = QModelIndex()) const override;
@@ -33,20 +39,35 @@ public:
   static constexpr auto confirmed_column_index = 2;
   static constexpr auto active_column_index = 3;
   static constexpr auto recovered_column_index = 4;
+  static constexpr auto column_count = 5;
 
 private:
-  QString country_name{};
-  qreal confirmed_cases{};
-  struct CountryTimelineData
+  /**
+   * Typed storage of the timeline: a contiguous array per column and a mask of the valid columns per row
+   */
+  struct TimelineColumns
   {
-    QDateTime date;
-    QVariant deaths;
-    QVariant confirmed_cases;
-    QVariant active_cases;
-    QVariant recovered_cases;
+    std::vector<int64_t> dates{};                                /**< seconds since epoch */
+    std::array<std::vector<uint32_t>, column_count - 1> cases{}; /**< deaths, confirmed, active and recovered cases */
+    std::vector<uint8_t> valid_columns{};                        /**< bit i is set if column i of the row is valid */
+
+    int size() const noexcept;
+    void reserve(std::size_t row_count);
+    void append(coronan::CountryData::TimelineData const& data_point);
+    bool is_valid(int row, int column) const noexcept;
+    bool same_date(int row, TimelineColumns const& other, int other_row) const noexcept;
+    bool same_row(int row, TimelineColumns const& other, int other_row) const noexcept;
   };
 
-  QList<CountryTimelineData> country_timeline_data;
+  static QVariant date_cell(TimelineColumns const& timeline, int row);
+  template <int Column>
+  static QVariant cases_cell(TimelineColumns const& timeline, int row);
+
+  void insert_rows(TimelineColumns new_timeline, int first_inserted_row, int inserted_row_count);
+
+  QString country_name{};
+  qreal confirmed_cases{};
+  TimelineColumns timeline{};
 };
 
 } // namespace coronan_ui
@@ -1,12 +1,16 @@
 #pragma once
+#include "coronan/cancellation.hpp"
+#include "coronan/corona-api_client.hpp"
 #include "coronan/corona-api_datatypes.hpp"
 #include "country_data_model.hpp"
 #include "country_overview_table_model.hpp"
 
+#include <QString>
 #include <QTableView>
 #include <QtCharts/QChartGlobal>
 #include <QtWidgets/QWidget>
 #include <string>
+#include <vector>
 
 QT_BEGIN_NAMESPACE
 class Ui_CoronanWidgetForm;
@@ -33,12 +37,29 @@ private Q_SLOTS:
   void update_ui();
 
 private:
-  coronan::CountryData get_country_data(std::string_view country_code);
   void populate_country_box();
+  void show_countries(std::vector<coronan::CountryInfo> countries);
+  void show_country_data(coronan::CountryData const& country_data);
+  void update_loading_indicator();
 
   CountryChartView* chartView = nullptr;
   Ui_CoronanWidgetForm* ui = nullptr;
 
+  // the responses are cached on disk, i.e. a (re-)started app paints the cached data at once while it is revalidated.
+  // the responses can be recorded/replayed (see main)
+  coronan::CoronaAPIClientType<coronan::ArchiveHTTPClient, coronan::DiskCachePolicy<>> api_client{};
+  // the pending requests, the request of the selected country is cancelled when another country is selected
+  coronan::CancellationSource countries_request{};
+  coronan::CancellationSource country_data_request{};
+  // the loading indicator is shown while any of the requests is pending. The result of a superseded (cancelled)
+  // request is dropped, i.e. only the latest country data request is tracked.
+  bool countries_loading = false;
+  bool country_data_loading = false;
+
+  std::vector<coronan::CountryInfo> shown_countries{};
+  QString selected_country{}; // persisted as the last viewed country
+  QString shown_country{};
+
   CountryOverviewTablewModel overview_model{};
   CountryDataModel country_data_model{};
 };
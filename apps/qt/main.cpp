@@ -1,7 +1,9 @@
+#include "coronan/corona-api_client.hpp"
 #include "coronan/http_client.hpp"
 #include "coronan/ssl_client.hpp"
 #include "mainwindow.h"
 
+#include <QCommandLineParser>
 #include <QDebug>
 #include <QString>
 #include <QtWidgets/QApplication>
@@ -11,9 +13,33 @@
 int main(int argc, char* argv[])
 {
   QApplication app(argc, argv);
+
+  QCommandLineParser command_line_parser;
+  command_line_parser.addHelpOption();
+  QCommandLineOption const record_option{QStringLiteral("record"),
+                                         QStringLiteral("Record the http responses to an archive <file>."),
+                                         QStringLiteral("file")};
+  QCommandLineOption const replay_option{QStringLiteral("replay"),
+                                         QStringLiteral("Replay the http responses of an archive <file> (offline)."),
+                                         QStringLiteral("file")};
+  command_line_parser.addOption(record_option);
+  command_line_parser.addOption(replay_option);
+  command_line_parser.process(app);
+  auto const record_file = command_line_parser.value(record_option).toStdString();
+  auto const replay_file = command_line_parser.value(replay_option).toStdString();
+
   QMainWindow window;
   try
   {
+    if (!replay_file.empty())
+    {
+      coronan::ArchiveHTTPClient::archive().load(replay_file);
+      coronan::ArchiveHTTPClient::set_mode(coronan::ArchiveMode::replay);
+    }
+    else if (!record_file.empty())
+    {
+      coronan::ArchiveHTTPClient::set_mode(coronan::ArchiveMode::record);
+    }
     window.show();
     window.setWindowTitle(QStringLiteral("Co[ro]nan"));
     auto const window_width = 1600;
@@ -21,7 +47,12 @@ int main(int argc, char* argv[])
     window.resize(window_width, window_height);
     auto* const widget = new coronan_ui::CoronanWidget();
     window.setCentralWidget(widget);
-    return app.exec(); // NOLINT(readability-static-accessed-through-instance)
+    auto const exit_code = app.exec(); // NOLINT(readability-static-accessed-through-instance)
+    if (!record_file.empty())
+    {
+      coronan::ArchiveHTTPClient::archive().save(record_file);
+    }
+    return exit_code;
   }
   catch (coronan::HTTPClientException const& ex)
   {
@@ -4,90 +4,219 @@
 #include "country_chart_view.hpp"
 #include "ui_mainwindow.h"
 
+#include <QCoreApplication>
 #include <QDebug>
+#include <QMetaObject>
+#include <QPointer>
+#include <QSettings>
+#include <QSignalBlocker>
 #include <QString>
 #include <QtWidgets/QHeaderView>
 #include <QtWidgets/QMessageBox>
 #include <algorithm>
+#include <memory>
+#include <optional>
 
 namespace coronan_ui {
 
+namespace {
+/**
+ * Return a completion handler of a request passing its result to handle_result in the GUI thread. The result is
+ * dropped if the request was cancelled (e.g. superseded) or the receiver was destroyed in the meantime.
+ */
+template <typename Value, typename ResultHandler>
+coronan::CompletionHandler<Value> in_gui_thread(QPointer<QObject> const& receiver,
+                                                coronan::CancellationToken const& cancellation,
+                                                ResultHandler handle_result)
+{
+  return [receiver, cancellation, handle_result](std::future<Value> result) {
+    if (cancellation.is_cancelled())
+    {
+      return;
+    }
+    auto shared_result = std::make_shared<std::future<Value>>(std::move(result));
+    QMetaObject::invokeMethod(
+        QCoreApplication::instance(),
+        [receiver, cancellation, handle_result, shared_result]() {
+          if (receiver != nullptr && !cancellation.is_cancelled())
+          {
+            handle_result(*shared_result);
+          }
+        },
+        Qt::QueuedConnection);
+  };
+}
+
+/**
+ * Return the result of a request, show its error in a message box otherwise
+ */
+template <typename Value>
+std::optional<Value> get_result(QWidget* parent, std::future<Value>& result)
+{
+  try
+  {
+    return result.get();
+  }
+  catch (coronan::SSLException const& ex)
+  {
+    qWarning() << ex.what();
+    QMessageBox::warning(parent, QStringLiteral("SSL Exception"), QString{ex.what()});
+  }
+  catch (coronan::HTTPClientException const& ex)
+  {
+    qWarning() << ex.what();
+    QMessageBox::warning(parent, QStringLiteral("HTTP Client Exception"), QString{ex.what()});
+  }
+  catch (std::exception const& ex)
+  {
+    qWarning() << ex.what();
+    QMessageBox::warning(parent, QStringLiteral("Exception"), QString{ex.what()});
+  }
+  return std::nullopt;
+}
+
+/**
+ * Settings of the application, e.g. the last viewed country
+ */
+QSettings application_settings()
+{
+  return QSettings{QStringLiteral("coronan"), QStringLiteral("coronan_gui")};
+}
+
+constexpr auto last_country_key = "last_country";
+} // namespace
+
 CoronanWidget::CoronanWidget(QWidget* parent) : QWidget(parent), ui{new Ui_CoronanWidgetForm}
 {
   ui->setupUi(this);
 
   ui->overviewTable->horizontalHeader()->setVisible(false);
   ui->overviewTable->setModel(&overview_model);
-
-  populate_country_box();
-  update_ui();
+  ui->timelineTable->setModel(&country_data_model);
+  ui->timelineTable->horizontalHeader()->setSectionResizeMode(QHeaderView::ResizeToContents);
 
   QObject::connect(ui->countryComboBox, qOverload<int>(&QComboBox::currentIndexChanged),
                    [this](int) { this->update_ui(); });
+
+  selected_country = application_settings().value(last_country_key, QStringLiteral("CH")).toString();
+  populate_country_box();
 }
 
 CoronanWidget::~CoronanWidget()
 {
+  countries_request.cancel();
+  country_data_request.cancel();
   delete ui;
 }
 
 void CoronanWidget::populate_country_box()
 {
-  auto* country_combo = ui->countryComboBox;
-  auto countries = coronan::CoronaAPIClient{}.request_countries();
-
-  std::sort(begin(countries), end(countries), [](auto const& a, auto const& b) { return a.name < b.name; });
-
-  std::for_each(cbegin(countries), cend(countries),
-                [=](auto const& country) { country_combo->addItem(country.name.c_str(), country.iso_code.c_str()); });
-
-  if (int const index = country_combo->findData("CH"); index != -1)
-  { // -1 for not found
-    country_combo->setCurrentIndex(index);
+  // Paint the cached (possibly stale) list at once, the requested list replaces it once it is revalidated
+  if (auto cached_countries = api_client.cached_countries(); cached_countries.has_value())
+  {
+    show_countries(std::move(cached_countries).value());
   }
+
+  countries_loading = true;
+  update_loading_indicator();
+  api_client.request_countries_async(
+      in_gui_thread<std::vector<coronan::CountryInfo>>(
+          this, countries_request.token(), [this](std::future<std::vector<coronan::CountryInfo>>& result) {
+            countries_loading = false;
+            update_loading_indicator();
+            if (auto countries = get_result(this, result); countries.has_value())
+            {
+              show_countries(std::move(countries).value());
+            }
+          }),
+      countries_request.token());
 }
 
-coronan::CountryData CoronanWidget::get_country_data(std::string_view country_code)
+void CoronanWidget::show_countries(std::vector<coronan::CountryInfo> countries)
 {
-  try
+  auto* country_combo = ui->countryComboBox;
+
+  std::sort(begin(countries), end(countries), [](auto const& a, auto const& b) { return a.name < b.name; });
+  auto const same_countries = std::equal(
+      cbegin(countries), cend(countries), cbegin(shown_countries), cend(shown_countries),
+      [](auto const& a, auto const& b) { return a.iso_code == b.iso_code && a.name == b.name; });
+  if (same_countries)
   {
-    return coronan::CoronaAPIClient{}.request_country_data(country_code);
+    return;
   }
-  catch (coronan::SSLException const& ex)
+  shown_countries = countries;
+
   {
-    qWarning() << ex.what();
-    QMessageBox::warning(this, QStringLiteral("SSL Exception"), QString{ex.what()});
+    // the country data is requested once the country box is populated
+    QSignalBlocker const block_index_changes{country_combo};
+    country_combo->clear();
+    std::for_each(cbegin(countries), cend(countries), [=](auto const& country) {
+      country_combo->addItem(country.name.c_str(), country.iso_code.c_str());
+    });
+
+    if (int const index = country_combo->findData(selected_country); index != -1)
+    { // -1 for not found
+      country_combo->setCurrentIndex(index);
+    }
   }
-  catch (coronan::HTTPClientException const& ex)
+  if (country_combo->currentData().toString() != shown_country)
   {
-    qWarning() << ex.what();
-    QMessageBox::warning(this, QStringLiteral("HTTP Client Exception"), QString{ex.what()});
+    update_ui();
   }
-  catch (std::exception const& ex)
+}
+
+void CoronanWidget::update_ui()
+{
+  // A superseded request stops using its connection and its result is dropped
+  country_data_request.cancel();
+  country_data_request = coronan::CancellationSource{};
+  country_data_loading = true;
+  update_loading_indicator();
+
+  auto const country_code = ui->countryComboBox->itemData(ui->countryComboBox->currentIndex()).toString();
+  selected_country = country_code;
+  application_settings().setValue(last_country_key, country_code);
+
+  // Paint the cached (possibly stale) data at once, the requested data replaces it once it is revalidated
+  if (auto const cached_data = api_client.cached_country_data(country_code.toStdString()); cached_data.has_value())
   {
-    qWarning() << ex.what();
-    QMessageBox::warning(this, QStringLiteral("Exception"), QString{ex.what()});
+    show_country_data(*cached_data);
   }
-  return {};
+
+  api_client.request_country_data_async(
+      country_code.toStdString(),
+      in_gui_thread<coronan::CountryData>(this, country_data_request.token(),
+                                          [this](std::future<coronan::CountryData>& result) {
+                                            country_data_loading = false;
+                                            update_loading_indicator();
+                                            if (auto const country_data = get_result(this, result);
+                                                country_data.has_value())
+                                            {
+                                              show_country_data(*country_data);
+                                            }
+                                          }),
+      country_data_request.token());
 }
 
-void CoronanWidget::update_ui()
+void CoronanWidget::update_loading_indicator()
 {
-  auto country_code = ui->countryComboBox->itemData(ui->countryComboBox->currentIndex()).toString();
-  auto const country_data = get_country_data(country_code.toStdString());
+  ui->loadingIndicator->setVisible(countries_loading || country_data_loading);
+}
+
+void CoronanWidget::show_country_data(coronan::CountryData const& country_data)
+{
+  shown_country = QString::fromStdString(country_data.info.iso_code);
   overview_model.populate_data(country_data);
+  // A revalidated timeline of the shown country only inserts its new days, i.e. the scroll position is kept
   country_data_model.populate_data(country_data);
   ui->overviewTable->horizontalHeader()->setSectionResizeMode(0, QHeaderView::ResizeToContents);
 
   if (chartView == nullptr)
   {
-    chartView = new coronan_ui::CountryChartView{&country_data_model};
+    chartView = new coronan_ui::CountryChartView{};
     ui->gridLayout->addWidget(chartView, 2, 1);
   }
-  else
-  {
-    chartView->update_ui(country_data_model);
-  }
+  chartView->update_ui(country_data);
 }
 
 } // namespace coronan_ui
@@ -0,0 +1,154 @@
+#include "country_data_model.hpp"
+
+#include <QModelIndex>
+#include <QVector>
+#include <catch2/catch.hpp>
+#include <cstdint>
+#include <initializer_list>
+#include <string>
+#include <vector>
+
+namespace {
+
+using coronan_ui::CountryDataModel;
+
+constexpr auto seconds_per_day = int64_t{24 * 60 * 60};
+
+coronan::CountryData create_country_data(std::string const& name, std::initializer_list<int> days)
+{
+  coronan::CountryData country_data{};
+  country_data.info.name = name;
+  for (auto const day : days)
+  {
+    coronan::CountryData::TimelineData data_point{};
+    data_point.date = day * seconds_per_day;
+    data_point.deaths = static_cast<uint32_t>(day);
+    data_point.confirmed = static_cast<uint32_t>(day * 10);
+    country_data.timeline.push_back(data_point);
+  }
+  return country_data;
+}
+
+struct RowRange
+{
+  int first{};
+  int last{};
+  int row_count{}; /**< row count of the model when the signal was emitted */
+
+  bool operator==(RowRange const& other) const
+  {
+    return first == other.first && last == other.last && row_count == other.row_count;
+  }
+};
+
+/**
+ * Records the change signals of a model, including the row count of the model when a signal was emitted
+ */
+struct ModelSignals
+{
+  explicit ModelSignals(CountryDataModel& model)
+  {
+    QObject::connect(&model, &CountryDataModel::rowsAboutToBeInserted,
+                     [this, &model](QModelIndex const& /*parent*/, int first, int last) {
+                       about_to_be_inserted.push_back(RowRange{first, last, model.rowCount()});
+                     });
+    QObject::connect(&model, &CountryDataModel::rowsInserted,
+                     [this, &model](QModelIndex const& /*parent*/, int first, int last) {
+                       inserted.push_back(RowRange{first, last, model.rowCount()});
+                     });
+    QObject::connect(&model, &CountryDataModel::dataChanged,
+                     [this, &model](QModelIndex const& top_left, QModelIndex const& bottom_right,
+                                    QVector<int> const& /*roles*/) {
+                       changed.push_back(RowRange{top_left.row(), bottom_right.row(), model.rowCount()});
+                     });
+    QObject::connect(&model, &CountryDataModel::modelReset, [this]() { ++resets; });
+  }
+
+  std::vector<RowRange> about_to_be_inserted{};
+  std::vector<RowRange> inserted{};
+  std::vector<RowRange> changed{};
+  int resets{};
+};
+
+uint32_t deaths(CountryDataModel const& model, int row)
+{
+  return model.data(model.index(row, CountryDataModel::deaths_column_index)).toUInt();
+}
+
+} // namespace
+
+SCENARIO("CountryDataModel updates the rows of a country incrementally", "[CountryDataModel]")
+{
+  GIVEN("A model showing three days of a country, the latest day first")
+  {
+    CountryDataModel testee{};
+    testee.populate_data(create_country_data("Switzerland", {5, 4, 3}));
+    ModelSignals model_signals{testee};
+
+    WHEN("a new day is added at the front and the values of the previous latest day changed")
+    {
+      auto country_data = create_country_data("Switzerland", {6, 5, 4, 3});
+      country_data.timeline[1].deaths = 55U;
+      testee.populate_data(country_data);
+
+      THEN("the new row is inserted at the front while the model still has the old rows before the insertion")
+      {
+        REQUIRE(model_signals.about_to_be_inserted == std::vector<RowRange>{{0, 0, 3}});
+        REQUIRE(model_signals.inserted == std::vector<RowRange>{{0, 0, 4}});
+        REQUIRE(model_signals.resets == 0);
+      }
+      THEN("only the changed row is reported as changed")
+      {
+        REQUIRE(model_signals.changed == std::vector<RowRange>{{1, 1, 4}});
+      }
+      THEN("the model returns the new data")
+      {
+        REQUIRE(testee.rowCount() == 4);
+        REQUIRE(deaths(testee, 0) == 6U);
+        REQUIRE(deaths(testee, 1) == 55U);
+        REQUIRE(deaths(testee, 3) == 3U);
+      }
+    }
+
+    WHEN("new days are added at the end")
+    {
+      testee.populate_data(create_country_data("Switzerland", {5, 4, 3, 2, 1}));
+
+      THEN("the new rows are inserted at the end and no row is reported as changed")
+      {
+        REQUIRE(model_signals.about_to_be_inserted == std::vector<RowRange>{{3, 4, 3}});
+        REQUIRE(model_signals.inserted == std::vector<RowRange>{{3, 4, 5}});
+        REQUIRE(model_signals.changed.empty());
+        REQUIRE(model_signals.resets == 0);
+        REQUIRE(deaths(testee, 0) == 5U);
+        REQUIRE(deaths(testee, 4) == 1U);
+      }
+    }
+
+    WHEN("the same days are shown with a changed value")
+    {
+      auto country_data = create_country_data("Switzerland", {5, 4, 3});
+      country_data.timeline[2].confirmed = 11U;
+      testee.populate_data(country_data);
+
+      THEN("no row is inserted and the changed row is reported as changed")
+      {
+        REQUIRE(model_signals.inserted.empty());
+        REQUIRE(model_signals.changed == std::vector<RowRange>{{2, 2, 3}});
+      }
+    }
+
+    WHEN("another country is shown")
+    {
+      testee.populate_data(create_country_data("Austria", {4, 3, 2, 1}));
+
+      THEN("the model is reset")
+      {
+        REQUIRE(model_signals.resets == 1);
+        REQUIRE(model_signals.inserted.empty());
+        REQUIRE(testee.rowCount() == 4);
+        REQUIRE(testee.country() == QString{"Austria"});
+      }
+    }
+  }
+}
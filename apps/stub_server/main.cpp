@@ -0,0 +1,298 @@
+#include "payload_generator.hpp"
+
+#include <Poco/File.h>
+#include <Poco/FileStream.h>
+#include <Poco/Net/Context.h>
+#include <Poco/Net/HTTPRequestHandler.h>
+#include <Poco/Net/HTTPRequestHandlerFactory.h>
+#include <Poco/Net/HTTPServer.h>
+#include <Poco/Net/HTTPServerParams.h>
+#include <Poco/Net/HTTPServerRequest.h>
+#include <Poco/Net/HTTPServerResponse.h>
+#include <Poco/Net/SSLManager.h>
+#include <Poco/Net/SecureServerSocket.h>
+#include <Poco/Net/ServerSocket.h>
+#include <Poco/Path.h>
+#include <Poco/StreamCopier.h>
+#include <Poco/URI.h>
+#include <atomic>
+#include <chrono>
+#include <csignal>
+#include <cstdint>
+#include <cstdlib>
+#include <fmt/core.h>
+#include <lyra/lyra.hpp>
+#include <memory>
+#include <optional>
+#include <random>
+#include <sstream>
+#include <string>
+#include <string_view>
+#include <thread>
+
+namespace {
+struct ServerOptions
+{
+  unsigned port = 8080;
+  unsigned threads = 16;
+  unsigned timeline_points = 100;
+  unsigned country_count = 250;
+  unsigned latency_ms = 0;
+  double error_rate = 0.0;
+  bool chunked = false;
+  std::string data_directory{};
+  std::string certificate_file{};
+  std::string private_key_file{};
+};
+
+ServerOptions parse_commandline_arguments(lyra::args const& args);
+
+// The country code is used as file name of a recorded payload, i.e. it must not reach outside of the data directory.
+// The path of the request URI is already percent-decoded, so an encoded "%2F" arrives as "/".
+constexpr auto is_valid_country_code = [](std::string_view country_code) {
+  return !country_code.empty() && country_code.find_first_of("/\\") == std::string_view::npos &&
+         country_code.find("..") == std::string_view::npos && country_code.find('\0') == std::string_view::npos;
+};
+
+/**
+ * The json payloads served by the server
+ */
+class Payloads
+{
+public:
+  explicit Payloads(ServerOptions const& options)
+      : data_directory{options.data_directory},
+        country_list{recorded_payload("", "countries.json").value_or(coronan_benchmarks::countries_json(
+            options.country_count))},
+        country{coronan_benchmarks::country_json(options.timeline_points)}
+  {
+  }
+
+  std::string const& countries() const noexcept
+  {
+    return country_list;
+  }
+
+  // A recorded country json is read for every request, so that it can be replaced while the server is running
+  std::string country_data(std::string const& country_code) const
+  {
+    return recorded_payload("countries", country_code + ".json").value_or(country);
+  }
+
+private:
+  std::optional<std::string> recorded_payload(std::string const& sub_directory, std::string const& file_name) const
+  {
+    if (data_directory.empty())
+    {
+      return std::nullopt;
+    }
+    auto path = Poco::Path{data_directory};
+    path.makeDirectory();
+    if (!sub_directory.empty())
+    {
+      path.pushDirectory(sub_directory);
+    }
+    path.setFileName(file_name);
+    auto const file_path = path.toString();
+    if (!Poco::File{file_path}.exists())
+    {
+      return std::nullopt;
+    }
+    Poco::FileInputStream file{file_path};
+    std::string payload;
+    Poco::StreamCopier::copyToString(file, payload);
+    return payload;
+  }
+
+  std::string const data_directory;
+  std::string const country_list;
+  std::string const country;
+};
+
+class CoronaAPIRequestHandler : public Poco::Net::HTTPRequestHandler
+{
+public:
+  CoronaAPIRequestHandler(ServerOptions const& server_options, Payloads const& server_payloads)
+      : options{server_options}, payloads{server_payloads}
+  {
+  }
+
+  void handleRequest(Poco::Net::HTTPServerRequest& request, Poco::Net::HTTPServerResponse& response) override
+  {
+    using Poco::Net::HTTPResponse;
+
+    if (options.latency_ms > 0)
+    {
+      std::this_thread::sleep_for(std::chrono::milliseconds{options.latency_ms});
+    }
+
+    auto const path = Poco::URI{request.getURI()}.getPath();
+    constexpr std::string_view country_path{"/countries/"};
+    if (request.getMethod() != Poco::Net::HTTPRequest::HTTP_GET)
+    {
+      send(response, HTTPResponse::HTTP_METHOD_NOT_ALLOWED, R"({"message":"Method not allowed"})");
+    }
+    else if (inject_error())
+    {
+      send(response, HTTPResponse::HTTP_INTERNAL_SERVER_ERROR, R"({"message":"Injected error"})");
+    }
+    else if (path == "/countries")
+    {
+      send(response, HTTPResponse::HTTP_OK, payloads.countries());
+    }
+    else if (path.size() > country_path.size() && path.compare(0, country_path.size(), country_path) == 0 &&
+             is_valid_country_code(std::string_view{path}.substr(country_path.size())))
+    {
+      send(response, HTTPResponse::HTTP_OK, payloads.country_data(path.substr(country_path.size())));
+    }
+    else
+    {
+      send(response, HTTPResponse::HTTP_NOT_FOUND, R"({"message":"Not found"})");
+    }
+  }
+
+private:
+  bool inject_error() const
+  {
+    thread_local std::mt19937 random_engine{std::random_device{}()};
+    std::uniform_real_distribution<double> distribution{0.0, 1.0};
+    return options.error_rate > 0.0 && distribution(random_engine) < options.error_rate;
+  }
+
+  void send(Poco::Net::HTTPServerResponse& response, Poco::Net::HTTPResponse::HTTPStatus status,
+            std::string const& payload) const
+  {
+    response.setStatusAndReason(status);
+    response.setContentType("application/json");
+    if (options.chunked)
+    {
+      response.setChunkedTransferEncoding(true);
+    }
+    else
+    {
+      response.setContentLength(static_cast<std::streamsize>(payload.size()));
+    }
+    response.send() << payload;
+  }
+
+  ServerOptions const& options;
+  Payloads const& payloads;
+};
+
+class CoronaAPIRequestHandlerFactory : public Poco::Net::HTTPRequestHandlerFactory
+{
+public:
+  CoronaAPIRequestHandlerFactory(ServerOptions const& server_options, Payloads const& server_payloads)
+      : options{server_options}, payloads{server_payloads}
+  {
+  }
+
+  Poco::Net::HTTPRequestHandler* createRequestHandler(Poco::Net::HTTPServerRequest const& /*request*/) override
+  {
+    return new CoronaAPIRequestHandler{options, payloads};
+  }
+
+private:
+  ServerOptions const& options;
+  Payloads const& payloads;
+};
+
+std::atomic<bool> termination_requested{false};
+
+extern "C" void request_termination(int /*signal*/)
+{
+  termination_requested = true;
+}
+
+Poco::Net::ServerSocket create_server_socket(ServerOptions const& options)
+{
+  auto const port = static_cast<std::uint16_t>(options.port);
+  if (options.certificate_file.empty())
+  {
+    return Poco::Net::ServerSocket{port};
+  }
+  Poco::Net::Context::Ptr const context = new Poco::Net::Context{
+      Poco::Net::Context::SERVER_USE, options.private_key_file, options.certificate_file, "",
+      Poco::Net::Context::VERIFY_NONE};
+  return Poco::Net::SecureServerSocket{port, 64, context};
+}
+} // namespace
+
+int main(int argc, char* argv[])
+{
+  auto const options = parse_commandline_arguments({argc, argv});
+
+  try
+  {
+    if (!options.certificate_file.empty())
+    {
+      Poco::Net::initializeSSL();
+    }
+    Payloads const payloads{options};
+
+    Poco::Net::HTTPServerParams::Ptr const server_params = new Poco::Net::HTTPServerParams;
+    server_params->setMaxThreads(static_cast<int>(options.threads));
+    Poco::Net::HTTPServer server{new CoronaAPIRequestHandlerFactory{options, payloads}, create_server_socket(options),
+                                 server_params};
+
+    std::signal(SIGINT, request_termination);
+    std::signal(SIGTERM, request_termination);
+    server.start();
+    fmt::print("Serving the corona-api on port {} ({}), stop with Ctrl-C\n", options.port,
+               options.certificate_file.empty() ? "http" : "https");
+
+    while (!termination_requested)
+    {
+      std::this_thread::sleep_for(std::chrono::milliseconds{100});
+    }
+    server.stopAll(true);
+  }
+  catch (std::exception const& ex)
+  {
+    fmt::print(stderr, "{}\n", ex.what());
+    std::exit(EXIT_FAILURE);
+  }
+  if (!options.certificate_file.empty())
+  {
+    Poco::Net::uninitializeSSL();
+  }
+  std::exit(EXIT_SUCCESS);
+}
+
+namespace {
+ServerOptions parse_commandline_arguments(lyra::args const& args)
+{
+  ServerOptions options{};
+  bool help_request = false;
+  auto command_line_parser =
+      lyra::cli_parser() | lyra::help(help_request) |
+      lyra::opt(options.port, "port")["-p"]["--port"]("Port to listen on") |
+      lyra::opt(options.threads, "threads")["--threads"]("Maximum number of request handler threads") |
+      lyra::opt(options.timeline_points, "points")["--timeline-points"]("Timeline points of a synthetic country") |
+      lyra::opt(options.country_count, "count")["--countries"]("Countries of the synthetic country list") |
+      lyra::opt(options.latency_ms, "milliseconds")["--latency"]("Latency injected into every response") |
+      lyra::opt(options.error_rate, "rate")["--error-rate"]("Fraction [0, 1] of requests answered with an error") |
+      lyra::opt(options.chunked)["--chunked"]("Send the responses with chunked transfer encoding") |
+      lyra::opt(options.data_directory, "directory")["--data-dir"](
+          "Directory of recorded json (countries.json, countries/{code}.json) served instead of synthetic json") |
+      lyra::opt(options.certificate_file, "file")["--certificate"]("Certificate (PEM) to serve https") |
+      lyra::opt(options.private_key_file, "file")["--private-key"]("Private key (PEM) of the certificate");
+
+  std::stringstream usage;
+  usage << command_line_parser;
+
+  if (auto const result = command_line_parser.parse(args); !result)
+  {
+    fmt::print(stderr, "Error in command line: {}\n", result.errorMessage());
+    fmt::print("{}\n", usage.str());
+    std::exit(EXIT_FAILURE);
+  }
+
+  if (help_request)
+  {
+    fmt::print("{}\n", usage.str());
+    std::exit(EXIT_SUCCESS);
+  }
+  return options;
+}
+} // namespace
@@ -0,0 +1,118 @@
+#include "allocation_counter.hpp"
+
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+namespace {
+
+std::atomic<std::size_t> allocation_count{0};
+std::atomic<std::size_t> allocated_bytes{0};
+std::atomic<std::size_t> peak_allocated_bytes{0};
+
+// The allocation size is stored in front of the returned memory block to know the size on delete.
+constexpr auto header_size = alignof(std::max_align_t);
+
+void* allocate(std::size_t size) noexcept
+{
+  auto* const block = static_cast<unsigned char*>(std::malloc(size + header_size));
+  if (block == nullptr)
+  {
+    return nullptr;
+  }
+  *reinterpret_cast<std::size_t*>(block) = size;
+
+  allocation_count.fetch_add(1, std::memory_order_relaxed);
+  auto const current = allocated_bytes.fetch_add(size, std::memory_order_relaxed) + size;
+  auto peak = peak_allocated_bytes.load(std::memory_order_relaxed);
+  while (current > peak && !peak_allocated_bytes.compare_exchange_weak(peak, current, std::memory_order_relaxed))
+  {
+  }
+  return block + header_size;
+}
+
+void deallocate(void* ptr) noexcept
+{
+  if (ptr == nullptr)
+  {
+    return;
+  }
+  auto* const block = static_cast<unsigned char*>(ptr) - header_size;
+  allocated_bytes.fetch_sub(*reinterpret_cast<std::size_t*>(block), std::memory_order_relaxed);
+  std::free(block);
+}
+
+void* allocate_or_throw(std::size_t size)
+{
+  if (auto* const ptr = allocate(size); ptr != nullptr)
+  {
+    return ptr;
+  }
+  throw std::bad_alloc{};
+}
+
+} // namespace
+
+namespace coronan_benchmarks {
+
+AllocationStatistics allocation_statistics() noexcept
+{
+  return AllocationStatistics{allocation_count.load(), allocated_bytes.load(), peak_allocated_bytes.load()};
+}
+
+void reset_peak_bytes() noexcept
+{
+  peak_allocated_bytes.store(allocated_bytes.load());
+}
+
+} // namespace coronan_benchmarks
+
+void* operator new(std::size_t size)
+{
+  return allocate_or_throw(size);
+}
+
+void* operator new[](std::size_t size)
+{
+  return allocate_or_throw(size);
+}
+
+void* operator new(std::size_t size, std::nothrow_t const& /*unused*/) noexcept
+{
+  return allocate(size);
+}
+
+void* operator new[](std::size_t size, std::nothrow_t const& /*unused*/) noexcept
+{
+  return allocate(size);
+}
+
+void operator delete(void* ptr) noexcept
+{
+  deallocate(ptr);
+}
+
+void operator delete[](void* ptr) noexcept
+{
+  deallocate(ptr);
+}
+
+void operator delete(void* ptr, std::size_t /*size*/) noexcept
+{
+  deallocate(ptr);
+}
+
+void operator delete[](void* ptr, std::size_t /*size*/) noexcept
+{
+  deallocate(ptr);
+}
+
+void operator delete(void* ptr, std::nothrow_t const& /*unused*/) noexcept
+{
+  deallocate(ptr);
+}
+
+void operator delete[](void* ptr, std::nothrow_t const& /*unused*/) noexcept
+{
+  deallocate(ptr);
+}
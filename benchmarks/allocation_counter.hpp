@@ -0,0 +1,52 @@
+#pragma once
+
+#include <cstddef>
+
+namespace coronan_benchmarks {
+
+/**
+ * Heap allocation statistics of the global operator new/delete
+ */
+struct AllocationStatistics
+{
+  std::size_t allocations{};   /**< number of allocations */
+  std::size_t current_bytes{}; /**< currently allocated bytes */
+  std::size_t peak_bytes{};    /**< peak allocated bytes since the last reset_peak_bytes() */
+};
+
+/**
+ * Return the current allocation statistics
+ */
+AllocationStatistics allocation_statistics() noexcept;
+
+/**
+ * Reset the peak to the currently allocated bytes
+ */
+void reset_peak_bytes() noexcept;
+
+/**
+ * Allocations of a single call
+ */
+struct CallAllocations
+{
+  std::size_t allocations{}; /**< number of allocations done by the call */
+  std::size_t peak_bytes{};  /**< peak heap memory used by the call (including its return value) */
+};
+
+/**
+ * Call func once and return the number of allocations and the peak heap memory used by the call
+ */
+template <typename Func>
+CallAllocations measure_allocations(Func&& func)
+{
+  reset_peak_bytes();
+  auto const before = allocation_statistics();
+  {
+    auto const result = func();
+    static_cast<void>(result);
+  }
+  auto const after = allocation_statistics();
+  return CallAllocations{after.allocations - before.allocations, after.peak_bytes - before.current_bytes};
+}
+
+} // namespace coronan_benchmarks
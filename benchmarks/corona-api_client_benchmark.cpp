@@ -0,0 +1,121 @@
+#include "allocation_counter.hpp"
+#include "coronan/corona-api_client.hpp"
+#include "coronan/ssl_client.hpp"
+#include "payload_generator.hpp"
+
+#include <benchmark/benchmark.h>
+#include <cstdlib>
+#include <sstream>
+#include <string>
+#include <string_view>
+
+namespace {
+
+// Stub client answering every get with the same payload, i.e. the benchmarks measure the client without network
+class PayloadHTTPClient
+{
+public:
+  static coronan::HTTPResponse get(std::string const& /*url*/)
+  {
+    return coronan::HTTPResponse{Poco::Net::HTTPResponse{Poco::Net::HTTPResponse::HTTP_OK}, payload};
+  }
+
+  inline static std::string payload{};
+};
+
+// Stub client passing the payload as stream to the body handler (see HTTPClientType::get_streamed)
+class PayloadStreamingHTTPClient
+{
+public:
+  template <typename BodyHandler>
+  static coronan::HTTPResponse get_streamed(std::string const& /*url*/, BodyHandler&& handle_body)
+  {
+    std::istringstream body{PayloadHTTPClient::payload};
+    handle_body(body);
+    return coronan::HTTPResponse{Poco::Net::HTTPResponse{Poco::Net::HTTPResponse::HTTP_OK}, ""};
+  }
+};
+
+template <typename ClientType>
+void request_country_data(benchmark::State& state)
+{
+  auto const timeline_points = static_cast<std::size_t>(state.range(0));
+  PayloadHTTPClient::payload = coronan_benchmarks::country_json(timeline_points);
+  auto const api_client = coronan::CoronaAPIClientType<ClientType>{};
+
+  for (auto _ : state)
+  {
+    auto country_data = api_client.request_country_data("ch");
+    benchmark::DoNotOptimize(country_data);
+  }
+
+  auto const iterations = static_cast<double>(state.iterations());
+  state.SetBytesProcessed(state.iterations() * static_cast<int64_t>(PayloadHTTPClient::payload.size()));
+  state.counters["points/s"] =
+      benchmark::Counter{iterations * static_cast<double>(timeline_points), benchmark::Counter::kIsRate};
+
+  auto const call_allocations =
+      coronan_benchmarks::measure_allocations([&api_client]() { return api_client.request_country_data("ch"); });
+  state.counters["allocs/call"] = static_cast<double>(call_allocations.allocations);
+  state.counters["peak_bytes"] = static_cast<double>(call_allocations.peak_bytes);
+}
+
+// Cost of a client (SSL initialization and context creation) per client instance, as before the shared SSL runtime
+void create_ssl_client(benchmark::State& state)
+{
+  for (auto _ : state)
+  {
+    auto ssl_client = coronan::SSLClient::create_with_accept_certificate_handler();
+    benchmark::DoNotOptimize(ssl_client);
+  }
+}
+
+// Construction of a client, the process wide SSL runtime is only initialized by the first client
+void construct_client(benchmark::State& state)
+{
+  for (auto _ : state)
+  {
+    auto api_client = coronan::CoronaAPIClient{};
+    benchmark::DoNotOptimize(&api_client);
+  }
+}
+
+template <typename ClientType>
+void request_country_data_from_server(benchmark::State& state, std::string const& server_url)
+{
+  auto const api_client = coronan::CoronaAPIClientType<ClientType>{server_url};
+  for (auto _ : state)
+  {
+    auto country_data = api_client.request_country_data("ch");
+    benchmark::DoNotOptimize(country_data);
+  }
+  state.counters["requests/s"] =
+      benchmark::Counter{static_cast<double>(state.iterations()), benchmark::Counter::kIsRate};
+}
+
+// Round trips to a local stand-in server of the corona-api (coronan_stub_server), e.g. started with
+// "coronan_stub_server --latency 20" and benchmarked with CORONAN_STUB_SERVER_URL=http://localhost:8080
+void request_country_data_from_stub_server(benchmark::State& state)
+{
+  auto const* const server_url = std::getenv("CORONAN_STUB_SERVER_URL");
+  if (server_url == nullptr)
+  {
+    state.SkipWithError("CORONAN_STUB_SERVER_URL is not set");
+  }
+  else if (std::string_view{server_url}.substr(0, 6) == "https:")
+  {
+    request_country_data_from_server<coronan::HTTPClient>(state, server_url);
+  }
+  else
+  {
+    request_country_data_from_server<coronan::PlainHTTPClient>(state, server_url);
+  }
+}
+
+BENCHMARK(create_ssl_client);
+BENCHMARK(construct_client);
+BENCHMARK_TEMPLATE(request_country_data, PayloadHTTPClient)->Arg(10)->Arg(1'000)->Arg(100'000);
+BENCHMARK_TEMPLATE(request_country_data, PayloadStreamingHTTPClient)->Arg(10)->Arg(1'000)->Arg(100'000);
+BENCHMARK(request_country_data_from_stub_server)->UseRealTime()->Threads(1)->Threads(8)->Threads(32);
+
+} // namespace
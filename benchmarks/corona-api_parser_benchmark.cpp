@@ -0,0 +1,133 @@
+#include "allocation_counter.hpp"
+#include "coronan/corona-api_parser.hpp"
+#include "payload_generator.hpp"
+
+#include <benchmark/benchmark.h>
+
+namespace {
+
+using coronan::api_parser::ParserEngine;
+
+// Names the implementation the simdjson engine selected for the CPU, or the engine it fell back to
+template <ParserEngine engine>
+void label_engine(benchmark::State& state)
+{
+  if constexpr (engine == ParserEngine::simdjson)
+  {
+    auto const implementation = coronan::api_parser::simdjson_implementation();
+    state.SetLabel(implementation.empty() ? "sax fallback" : implementation);
+  }
+}
+
+template <ParserEngine engine>
+void parse_country(benchmark::State& state)
+{
+  auto const timeline_points = static_cast<std::size_t>(state.range(0));
+  auto const json = coronan_benchmarks::country_json(timeline_points);
+  label_engine<engine>(state);
+
+  for (auto _ : state)
+  {
+    auto country_data = coronan::api_parser::parse_country(json, engine);
+    benchmark::DoNotOptimize(country_data);
+  }
+
+  auto const iterations = static_cast<double>(state.iterations());
+  state.SetBytesProcessed(state.iterations() * static_cast<int64_t>(json.size()));
+  state.counters["points/s"] =
+      benchmark::Counter{iterations * static_cast<double>(timeline_points), benchmark::Counter::kIsRate};
+
+  auto const call_allocations =
+      coronan_benchmarks::measure_allocations([&json]() { return coronan::api_parser::parse_country(json, engine); });
+  state.counters["allocs/call"] = static_cast<double>(call_allocations.allocations);
+  state.counters["peak_bytes"] = static_cast<double>(call_allocations.peak_bytes);
+  if constexpr (engine == ParserEngine::dom)
+  {
+    auto const arena_statistics = coronan::api_parser::DocumentArena::this_thread().statistics();
+    state.counters["arena_bytes"] = static_cast<double>(arena_statistics.bytes_retained);
+    state.counters["arena_allocs_avoided"] = static_cast<double>(arena_statistics.allocations_avoided);
+  }
+}
+
+// Parses only the fields of a dashboard: the latest data and the confirmed cases of the timeline
+template <ParserEngine engine>
+void parse_country_projected(benchmark::State& state)
+{
+  auto const timeline_points = static_cast<std::size_t>(state.range(0));
+  auto const json = coronan_benchmarks::country_json(timeline_points);
+  auto const fields = coronan::fields::latest | coronan::fields::timeline::confirmed;
+  label_engine<engine>(state);
+
+  for (auto _ : state)
+  {
+    auto country_data = coronan::api_parser::parse_country(json, fields, engine);
+    benchmark::DoNotOptimize(country_data);
+  }
+
+  state.SetBytesProcessed(state.iterations() * static_cast<int64_t>(json.size()));
+
+  auto const call_allocations = coronan_benchmarks::measure_allocations(
+      [&json, fields]() { return coronan::api_parser::parse_country(json, fields, engine); });
+  state.counters["allocs/call"] = static_cast<double>(call_allocations.allocations);
+  state.counters["peak_bytes"] = static_cast<double>(call_allocations.peak_bytes);
+}
+
+template <ParserEngine engine>
+void parse_countries(benchmark::State& state)
+{
+  auto const country_count = static_cast<std::size_t>(state.range(0));
+  auto const json = coronan_benchmarks::countries_json(country_count);
+  label_engine<engine>(state);
+
+  for (auto _ : state)
+  {
+    auto country_list = coronan::api_parser::parse_countries(json, engine);
+    benchmark::DoNotOptimize(country_list);
+  }
+
+  auto const iterations = static_cast<double>(state.iterations());
+  state.SetBytesProcessed(state.iterations() * static_cast<int64_t>(json.size()));
+  state.counters["countries/s"] =
+      benchmark::Counter{iterations * static_cast<double>(country_count), benchmark::Counter::kIsRate};
+
+  auto const call_allocations =
+      coronan_benchmarks::measure_allocations([&json]() { return coronan::api_parser::parse_countries(json, engine); });
+  state.counters["allocs/call"] = static_cast<double>(call_allocations.allocations);
+  state.counters["peak_bytes"] = static_cast<double>(call_allocations.peak_bytes);
+}
+
+// Parses every document in a new arena, i.e. allocates the DOM of every document as without a retained arena
+void parse_country_fresh_arena(benchmark::State& state)
+{
+  auto const timeline_points = static_cast<std::size_t>(state.range(0));
+  auto const json = coronan_benchmarks::country_json(timeline_points);
+
+  for (auto _ : state)
+  {
+    coronan::api_parser::DocumentArena arena{};
+    auto country_data = coronan::api_parser::parse_country(json, arena);
+    benchmark::DoNotOptimize(country_data);
+  }
+
+  state.SetBytesProcessed(state.iterations() * static_cast<int64_t>(json.size()));
+
+  auto const call_allocations = coronan_benchmarks::measure_allocations([&json]() {
+    coronan::api_parser::DocumentArena arena{};
+    return coronan::api_parser::parse_country(json, arena);
+  });
+  state.counters["allocs/call"] = static_cast<double>(call_allocations.allocations);
+  state.counters["peak_bytes"] = static_cast<double>(call_allocations.peak_bytes);
+}
+
+BENCHMARK_TEMPLATE(parse_country, ParserEngine::dom)->Arg(10)->Arg(1'000)->Arg(100'000);
+BENCHMARK(parse_country_fresh_arena)->Arg(10)->Arg(1'000)->Arg(100'000);
+BENCHMARK_TEMPLATE(parse_country, ParserEngine::sax)->Arg(10)->Arg(1'000)->Arg(100'000);
+BENCHMARK_TEMPLATE(parse_country, ParserEngine::simdjson)->Arg(10)->Arg(1'000)->Arg(100'000);
+BENCHMARK_TEMPLATE(parse_country_projected, ParserEngine::dom)->Arg(10)->Arg(1'000)->Arg(100'000);
+BENCHMARK_TEMPLATE(parse_country_projected, ParserEngine::sax)->Arg(10)->Arg(1'000)->Arg(100'000);
+BENCHMARK_TEMPLATE(parse_country_projected, ParserEngine::simdjson)->Arg(10)->Arg(1'000)->Arg(100'000);
+BENCHMARK_TEMPLATE(parse_countries, ParserEngine::dom)->Arg(10)->Arg(1'000)->Arg(100'000);
+BENCHMARK_TEMPLATE(parse_countries, ParserEngine::sax)->Arg(10)->Arg(1'000)->Arg(100'000);
+BENCHMARK_TEMPLATE(parse_countries, ParserEngine::simdjson)->Arg(10)->Arg(1'000)->Arg(100'000);
+
+} // namespace
@@ -0,0 +1,75 @@
+#include "coronan/corona-api_parser.hpp"
+#include "country_chart_series.hpp"
+#include "country_data_model.hpp"
+#include "payload_generator.hpp"
+
+#include <QDateTime>
+#include <QPointF>
+#include <QVector>
+#include <algorithm>
+#include <array>
+#include <benchmark/benchmark.h>
+
+namespace {
+
+using coronan_ui::CountryDataModel;
+
+void set_points_counter(benchmark::State& state)
+{
+  state.counters["points/s"] = benchmark::Counter{static_cast<double>(state.iterations()) *
+                                                      static_cast<double>(state.range(0)),
+                                                  benchmark::Counter::kIsRate};
+}
+
+/**
+ * The series built through the CountryDataModel like a QVXYModelMapper does it: every coordinate is read through
+ * QAbstractItemModel::data() as QVariant.
+ */
+void map_chart_series_through_model(benchmark::State& state)
+{
+  auto const timeline_points = static_cast<std::size_t>(state.range(0));
+  auto const country_data = coronan::api_parser::parse_country(coronan_benchmarks::country_json(timeline_points));
+  CountryDataModel model{};
+  constexpr std::array<int, 4> value_columns{
+      CountryDataModel::deaths_column_index, CountryDataModel::confirmed_column_index,
+      CountryDataModel::active_column_index, CountryDataModel::recovered_column_index};
+
+  for (auto _ : state)
+  {
+    model.populate_data(country_data);
+    std::array<QVector<QPointF>, value_columns.size()> series{};
+    qreal max_cases = 0;
+    for (int row = 0; row < model.rowCount(); ++row)
+    {
+      auto const date = static_cast<qreal>(
+          model.data(model.index(row, CountryDataModel::date_column_index)).toDateTime().toMSecsSinceEpoch());
+      for (std::size_t i = 0; i < value_columns.size(); ++i)
+      {
+        auto const value = model.data(model.index(row, value_columns[i])).toReal();
+        series[i].append(QPointF{date, value});
+        max_cases = std::max(max_cases, value);
+      }
+    }
+    benchmark::DoNotOptimize(series);
+    benchmark::DoNotOptimize(max_cases);
+  }
+  set_points_counter(state);
+}
+
+void create_chart_series(benchmark::State& state)
+{
+  auto const timeline_points = static_cast<std::size_t>(state.range(0));
+  auto const country_data = coronan::api_parser::parse_country(coronan_benchmarks::country_json(timeline_points));
+
+  for (auto _ : state)
+  {
+    auto chart_series = coronan_ui::create_chart_series(country_data);
+    benchmark::DoNotOptimize(chart_series);
+  }
+  set_points_counter(state);
+}
+
+BENCHMARK(map_chart_series_through_model)->Arg(10)->Arg(1'000)->Arg(100'000);
+BENCHMARK(create_chart_series)->Arg(10)->Arg(1'000)->Arg(100'000);
+
+} // namespace
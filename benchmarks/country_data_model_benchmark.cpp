@@ -0,0 +1,81 @@
+#include "allocation_counter.hpp"
+#include "coronan/corona-api_parser.hpp"
+#include "country_data_model.hpp"
+#include "payload_generator.hpp"
+
+#include <benchmark/benchmark.h>
+
+namespace {
+
+void populate_country_data_model(benchmark::State& state)
+{
+  auto const timeline_points = static_cast<std::size_t>(state.range(0));
+  auto const country_data = coronan::api_parser::parse_country(coronan_benchmarks::country_json(timeline_points));
+  coronan_ui::CountryDataModel model{};
+
+  for (auto _ : state)
+  {
+    model.populate_data(country_data);
+    benchmark::DoNotOptimize(&model);
+  }
+
+  state.counters["points/s"] = benchmark::Counter{
+      static_cast<double>(state.iterations()) * static_cast<double>(timeline_points), benchmark::Counter::kIsRate};
+
+  auto const call_allocations = coronan_benchmarks::measure_allocations([&model, &country_data]() {
+    model.populate_data(country_data);
+    return model.rowCount();
+  });
+  state.counters["allocs/call"] = static_cast<double>(call_allocations.allocations);
+  state.counters["peak_bytes"] = static_cast<double>(call_allocations.peak_bytes);
+}
+
+BENCHMARK(populate_country_data_model)->Arg(10)->Arg(1'000)->Arg(100'000);
+
+void add_day_to_country_data_model(benchmark::State& state)
+{
+  auto const timeline_points = static_cast<std::size_t>(state.range(0));
+  auto const country_data = coronan::api_parser::parse_country(coronan_benchmarks::country_json(timeline_points));
+  auto previous_day_data = country_data;
+  previous_day_data.timeline.erase(previous_day_data.timeline.begin());
+  coronan_ui::CountryDataModel model{};
+
+  for (auto _ : state)
+  {
+    state.PauseTiming();
+    model.populate_data(previous_day_data);
+    state.ResumeTiming();
+    model.populate_data(country_data);
+    benchmark::DoNotOptimize(&model);
+  }
+}
+
+BENCHMARK(add_day_to_country_data_model)->Arg(10)->Arg(1'000)->Arg(100'000);
+
+void read_country_data_model(benchmark::State& state)
+{
+  auto const timeline_points = static_cast<std::size_t>(state.range(0));
+  auto const country_data = coronan::api_parser::parse_country(coronan_benchmarks::country_json(timeline_points));
+  coronan_ui::CountryDataModel model{};
+  model.populate_data(country_data);
+
+  for (auto _ : state)
+  {
+    for (int row = 0; row < model.rowCount(); ++row)
+    {
+      for (int column = 0; column < model.columnCount(); ++column)
+      {
+        benchmark::DoNotOptimize(model.data(model.index(row, column)));
+      }
+    }
+  }
+
+  state.counters["cells/s"] =
+      benchmark::Counter{static_cast<double>(state.iterations()) * static_cast<double>(timeline_points) *
+                             static_cast<double>(coronan_ui::CountryDataModel::column_count),
+                         benchmark::Counter::kIsRate};
+}
+
+BENCHMARK(read_country_data_model)->Arg(10)->Arg(1'000)->Arg(100'000);
+
+} // namespace
@@ -0,0 +1,45 @@
+#include "payload_generator.hpp"
+
+namespace coronan_benchmarks {
+
+std::string country_json(std::size_t timeline_points)
+{
+  std::string json = R"({"data":{"coordinates":{"latitude":47,"longitude":8},"name":"Switzerland","code":"CH",)"
+                     R"("population":7581000,"updated_at":"2020-04-03T00:27:34.432Z",)"
+                     R"("today":{"deaths":48,"confirmed":1059},)"
+                     R"("latest_data":{"deaths":536,"confirmed":18827,"recovered":4013,"critical":348,)"
+                     R"("calculated":{"death_rate":2.8469750889679712,"recovery_rate":21.315132522441175,)"
+                     R"("recovered_vs_death_ratio":null,"cases_per_million_population":2175}},"timeline":[)";
+
+  for (std::size_t point = 0; point < timeline_points; ++point)
+  {
+    auto const value = std::to_string(point);
+    json += point == 0 ? "{" : ",{";
+    json += R"("updated_at":"2020-04-03T00:20:32.326Z","date":"2020-04-03","deaths":)" + value;
+    json += R"(,"confirmed":)" + value + R"(,"active":)" + value + R"(,"recovered":)" + value;
+    json += R"(,"new_confirmed":)" + value + R"(,"new_recovered":)" + value + R"(,"new_deaths":)" + value;
+    json += R"(,"is_in_progress":false})";
+  }
+  json += "]}}";
+  return json;
+}
+
+std::string countries_json(std::size_t country_count)
+{
+  std::string json = R"({"data":[)";
+  for (std::size_t country = 0; country < country_count; ++country)
+  {
+    auto const code = std::string{static_cast<char>('A' + country / 26 % 26), static_cast<char>('A' + country % 26)};
+    json += country == 0 ? "{" : ",{";
+    json += R"("coordinates":{"latitude":47,"longitude":8},"name":"Country )" + std::to_string(country);
+    json += R"(","code":")" + code + R"(","population":7581000,"updated_at":"2020-04-03T00:27:34.432Z",)";
+    json += R"("today":{"deaths":48,"confirmed":1059},"latest_data":{"deaths":536,"confirmed":18827,)";
+    json += R"("recovered":4013,"critical":348,"calculated":{"death_rate":2.8469750889679712,)";
+    json += R"("recovery_rate":21.315132522441175,"recovered_vs_death_ratio":null,)";
+    json += R"("cases_per_million_population":2175}}})";
+  }
+  json += "]}";
+  return json;
+}
+
+} // namespace coronan_benchmarks
@@ -0,0 +1,18 @@
+#pragma once
+
+#include <cstddef>
+#include <string>
+
+namespace coronan_benchmarks {
+
+/**
+ * Generate a corona-api country json (as returned by /countries/{code}) with timeline_points data points
+ */
+std::string country_json(std::size_t timeline_points);
+
+/**
+ * Generate a corona-api country list json (as returned by /countries) with country_count countries
+ */
+std::string countries_json(std::size_t country_count);
+
+} // namespace coronan_benchmarks
@@ -0,0 +1,54 @@
+#include "coronan/corona-api_parser.hpp"
+#include "payload_generator.hpp"
+
+#include <algorithm>
+#include <benchmark/benchmark.h>
+#include <cstdint>
+
+namespace {
+
+using Metric = coronan::Timeline::Metric;
+
+// Max confirmed and sum of new deaths over the row wise timeline of CountryData
+void scan_timeline_rows(benchmark::State& state)
+{
+  auto const timeline_points = static_cast<std::size_t>(state.range(0));
+  auto const country_data = coronan::api_parser::parse_country(coronan_benchmarks::country_json(timeline_points));
+
+  for (auto _ : state)
+  {
+    uint32_t max_confirmed = 0;
+    uint64_t sum_new_deaths = 0;
+    for (auto const& point : country_data.timeline)
+    {
+      max_confirmed = std::max(max_confirmed, point.confirmed.value_or(0));
+      sum_new_deaths += point.new_deaths.value_or(0);
+    }
+    benchmark::DoNotOptimize(max_confirmed);
+    benchmark::DoNotOptimize(sum_new_deaths);
+  }
+  state.counters["points/s"] = benchmark::Counter{
+      static_cast<double>(state.iterations()) * static_cast<double>(timeline_points), benchmark::Counter::kIsRate};
+}
+
+// Max confirmed and sum of new deaths over the columnar Timeline
+void scan_timeline_columns(benchmark::State& state)
+{
+  auto const timeline_points = static_cast<std::size_t>(state.range(0));
+  auto const timeline = coronan::api_parser::parse_timeline(coronan_benchmarks::country_json(timeline_points));
+
+  for (auto _ : state)
+  {
+    auto max_confirmed = timeline.max(Metric::confirmed);
+    auto sum_new_deaths = timeline.sum(Metric::new_deaths);
+    benchmark::DoNotOptimize(max_confirmed);
+    benchmark::DoNotOptimize(sum_new_deaths);
+  }
+  state.counters["points/s"] = benchmark::Counter{
+      static_cast<double>(state.iterations()) * static_cast<double>(timeline_points), benchmark::Counter::kIsRate};
+}
+
+BENCHMARK(scan_timeline_rows)->Arg(1'000)->Arg(100'000);
+BENCHMARK(scan_timeline_columns)->Arg(1'000)->Arg(100'000);
+
+} // namespace
@@ -19,13 +19,18 @@ macro(run_conan)
 
   include(${CMAKE_BINARY_DIR}/conan.cmake)
 
+  set(CONAN_REQUIRES poco/1.11.0 rapidjson/1.1.0 lyra/1.5.1 fmt/8.0.1
+                     catch2/2.13.7)
+  if(ENABLE_BENCHMARKS)
+    list(APPEND CONAN_REQUIRES benchmark/1.6.0)
+  endif()
+  if(ENABLE_SIMDJSON)
+    list(APPEND CONAN_REQUIRES simdjson/3.10.1)
+  endif()
+
   conan_cmake_configure(
     REQUIRES
-    poco/1.11.0
-    rapidjson/1.1.0
-    lyra/1.5.1
-    fmt/8.0.1
-    catch2/2.13.7
+    ${CONAN_REQUIRES}
     GENERATORS
     cmake_find_package_multi
     OPTIONS
@@ -0,0 +1,134 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <exception>
+#include <memory>
+#include <streambuf>
+
+namespace coronan {
+
+/**
+ * Thrown by an operation which was cancelled (see CancellationToken)
+ */
+class OperationCancelledException : public std::exception
+{
+public:
+  char const* what() const noexcept override
+  {
+    return "Operation cancelled";
+  }
+};
+
+/**
+ * Observes the cancellation of a CancellationSource. A default constructed token is never cancelled.
+ */
+class CancellationToken
+{
+public:
+  CancellationToken() = default;
+
+  /**
+   * Return true if the operation was cancelled
+   */
+  bool is_cancelled() const noexcept
+  {
+    return state != nullptr && state->load();
+  }
+
+  /**
+   * Return true if the token belongs to a CancellationSource, i.e. if it can be cancelled at all
+   */
+  bool can_be_cancelled() const noexcept
+  {
+    return state != nullptr;
+  }
+
+  /**
+   * Throw an OperationCancelledException if the operation was cancelled
+   */
+  void throw_if_cancelled() const
+  {
+    if (is_cancelled())
+    {
+      throw OperationCancelledException{};
+    }
+  }
+
+private:
+  friend class CancellationSource;
+  explicit CancellationToken(std::shared_ptr<std::atomic<bool> const> cancelled) : state{std::move(cancelled)}
+  {
+  }
+
+  std::shared_ptr<std::atomic<bool> const> state{};
+};
+
+/**
+ * Cancels the operations observing its tokens, e.g. a superseded request
+ */
+class CancellationSource
+{
+public:
+  /**
+   * Return a token observing this source
+   */
+  CancellationToken token() const
+  {
+    return CancellationToken{state};
+  }
+
+  /**
+   * Cancel the operations observing the tokens of this source
+   */
+  void cancel() noexcept
+  {
+    *state = true;
+  }
+
+  /**
+   * Return true if cancel() was called
+   */
+  bool is_cancelled() const noexcept
+  {
+    return state->load();
+  }
+
+private:
+  std::shared_ptr<std::atomic<bool>> state = std::make_shared<std::atomic<bool>>(false);
+};
+
+/**
+ * A stream buffer reading from another stream buffer which throws an OperationCancelledException as soon as the
+ * operation of the token is cancelled, i.e. a reader of the stream stops within one buffer of data.
+ *
+ * Use it with a stream which rethrows the exception (exceptions(std::ios::badbit)).
+ */
+class CancellableStreamBuffer : public std::streambuf
+{
+public:
+  CancellableStreamBuffer(std::streambuf* source, CancellationToken cancellation)
+      : source_{source}, cancellation_{std::move(cancellation)}
+  {
+  }
+
+protected:
+  int_type underflow() override
+  {
+    cancellation_.throw_if_cancelled();
+    auto const read = source_->sgetn(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+    if (read <= 0)
+    {
+      return traits_type::eof();
+    }
+    setg(buffer.data(), buffer.data(), buffer.data() + read);
+    return traits_type::to_int_type(buffer.front());
+  }
+
+private:
+  std::streambuf* source_;
+  CancellationToken cancellation_;
+  std::array<char, 4096> buffer{};
+};
+
+} // namespace coronan
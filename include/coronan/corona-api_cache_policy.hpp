@@ -0,0 +1,311 @@
+#pragma once
+
+#include "coronan/corona-api_datatypes.hpp"
+#include "coronan/disk_cache.hpp"
+#include "coronan/http_client.hpp"
+#include "coronan/lru_cache.hpp"
+
+#include <chrono>
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <type_traits>
+#include <utility>
+
+namespace coronan {
+
+/**
+ * Result of a (conditional) fetch passed to a cache policy
+ */
+template <typename Value>
+struct FetchResult
+{
+  using value_type = Value;
+
+  std::optional<Value> value{};     /**< parsed response, std::nullopt if the server answered HTTP_NOT_MODIFIED */
+  HTTPCacheValidators validators{}; /**< cache validators of the response */
+};
+
+// Cache policies of the CoronaAPIClientType implement
+//   template <typename Fetch> Value get_or_fetch(std::string const& key, Fetch&& fetch)
+// where key is the request url (with a fragment naming the fields of a projected request) and
+// fetch(HTTPCacheValidators const&) requests the url (conditionally, if validators are given) and returns a
+// FetchResult<Value>, and
+//   template <typename Value> std::optional<Value> get_cached(std::string const& key)
+// which returns the cached value of key without fetching it.
+namespace detail {
+template <typename Fetch>
+using fetched_value_t = typename std::invoke_result_t<Fetch, HTTPCacheValidators const&>::value_type;
+
+/**
+ * Return the fetched value of key
+ * @throw HTTPClientException if the server answered HTTP_NOT_MODIFIED although there is no cached value of key, e.g.
+ * because no validators were sent
+ */
+template <typename Value>
+Value take_fetched_value(FetchResult<Value>&& result, std::string const& key)
+{
+  if (!result.value.has_value())
+  {
+    throw HTTPClientException{std::string{"Error fetching url \""} + key +
+                              "\". Server answered HTTP_NOT_MODIFIED without a cached response."};
+  }
+  return std::move(result.value).value();
+}
+} // namespace detail
+
+/**
+ * Cache policy of the CoronaAPIClientType without caching. Every request is fetched.
+ */
+struct NoCachePolicy
+{
+  /**
+   * Return the value fetched by fetch
+   */
+  template <typename Fetch>
+  auto get_or_fetch(std::string const& key, Fetch&& fetch)
+  {
+    return detail::take_fetched_value(fetch(HTTPCacheValidators{}), key);
+  }
+
+  /**
+   * Return std::nullopt, nothing is cached
+   */
+  template <typename Value>
+  std::optional<Value> get_cached(std::string const& /*key*/) const
+  {
+    return std::nullopt;
+  }
+};
+
+/**
+ * Configuration of the LRUCachePolicy
+ */
+struct LRUCacheConfig
+{
+  std::size_t max_country_data_entries{32};                        /**< maximum number of cached CountryData */
+  std::chrono::milliseconds time_to_live{std::chrono::minutes{5}}; /**< time a cached entry is valid */
+};
+
+/**
+ * Cache policy of the CoronaAPIClientType caching the parsed CountryData and CountryListObject in memory in LRU caches.
+ *
+ * The policy is a handle to the caches: copies of a policy (and therefore clients constructed with copies of it) share
+ * the same caches.
+ */
+template <typename Clock = std::chrono::steady_clock>
+class LRUCachePolicy
+{
+public:
+  /**
+   * Constructor
+   * @param config cache configuration
+   */
+  explicit LRUCachePolicy(LRUCacheConfig const& config = {})
+      : caches{std::make_shared<Caches>(config.max_country_data_entries,
+                                        std::chrono::duration_cast<typename Clock::duration>(config.time_to_live))}
+  {
+  }
+
+  /**
+   * Return the cached value of key if there is a valid one, otherwise fetch and cache it.
+   * @param key cache key (request url)
+   * @param fetch callable fetching either CountryData or CountryListObject
+   */
+  template <typename Fetch>
+  auto get_or_fetch(std::string const& key, Fetch&& fetch)
+  {
+    auto& cache = cache_for<detail::fetched_value_t<Fetch>>();
+    if (auto cached_value = cache.get(key); cached_value.has_value())
+    {
+      return std::move(cached_value).value();
+    }
+    auto value = detail::take_fetched_value(fetch(HTTPCacheValidators{}), key);
+    cache.put(key, value);
+    return value;
+  }
+
+  /**
+   * Return the cached value of key if there is a valid one
+   * @tparam Value CountryData or CountryListObject
+   */
+  template <typename Value>
+  std::optional<Value> get_cached(std::string const& key)
+  {
+    return cache_for<Value>().get(key);
+  }
+
+  /**
+   * Return the usage counters of the CountryData cache
+   */
+  CacheStatistics country_data_statistics() const
+  {
+    return caches->country_data.statistics();
+  }
+
+  /**
+   * Return the usage counters of the country list cache
+   */
+  CacheStatistics country_list_statistics() const
+  {
+    return caches->country_list.statistics();
+  }
+
+  /**
+   * Remove all cached entries
+   */
+  void clear()
+  {
+    caches->country_data.clear();
+    caches->country_list.clear();
+  }
+
+private:
+  struct Caches
+  {
+    Caches(std::size_t max_country_data_entries, typename Clock::duration time_to_live)
+        : country_data{max_country_data_entries, time_to_live}, country_list{1, time_to_live}
+    {
+    }
+
+    LRUCache<std::string, CountryData, Clock> country_data;
+    LRUCache<std::string, CountryListObject, Clock> country_list;
+  };
+
+  template <typename Value>
+  auto& cache_for()
+  {
+    if constexpr (std::is_same_v<Value, CountryData>)
+    {
+      return caches->country_data;
+    }
+    else
+    {
+      static_assert(std::is_same_v<Value, CountryListObject>, "Unsupported cache value type");
+      return caches->country_list;
+    }
+  }
+
+  std::shared_ptr<Caches> caches;
+};
+
+/**
+ * Configuration of the DiskCachePolicy
+ */
+struct DiskCacheConfig
+{
+  std::string directory{DiskCache::default_directory()};      /**< cache directory */
+  std::chrono::seconds time_to_live{std::chrono::minutes{5}}; /**< time a cached entry is used without revalidation */
+};
+
+/**
+ * Cache policy of the CoronaAPIClientType caching the parsed responses on disk (see DiskCache), i.e. across
+ * processes.
+ *
+ * An entry younger than the time to live is returned without a request. An older entry is revalidated with a
+ * conditional GET using its ETag and Last-Modified validators. If the server answers HTTP_NOT_MODIFIED the stored
+ * value is returned (without parsing) and its time to live restarts. Copies of a policy share the statistics.
+ */
+template <typename Clock = std::chrono::system_clock>
+class DiskCachePolicy
+{
+public:
+  /**
+   * Constructor
+   * @param config cache configuration
+   */
+  explicit DiskCachePolicy(DiskCacheConfig config = {})
+      : cache{std::move(config.directory)}, time_to_live{config.time_to_live}, state{std::make_shared<State>()}
+  {
+  }
+
+  /**
+   * Return the stored value of key if it is fresh or not modified, otherwise fetch and store it.
+   * @param key cache key (request url)
+   * @param fetch callable fetching either CountryData or CountryListObject
+   */
+  template <typename Fetch>
+  auto get_or_fetch(std::string const& key, Fetch&& fetch)
+  {
+    using Value = detail::fetched_value_t<Fetch>;
+    auto const now = std::chrono::duration_cast<std::chrono::seconds>(Clock::now().time_since_epoch());
+
+    auto cached_entry = cache.template load<Value>(key);
+    if (cached_entry.has_value())
+    {
+      if (now - cached_entry->stored_at < time_to_live)
+      {
+        count(&CacheStatistics::hits);
+        return std::move(cached_entry->value);
+      }
+      count(&CacheStatistics::expirations);
+    }
+
+    auto result = fetch(cached_entry.has_value() ? cached_entry->validators : HTTPCacheValidators{});
+    if (!result.value.has_value() && cached_entry.has_value())
+    {
+      count(&CacheStatistics::revalidations);
+      cached_entry->stored_at = now;
+      cache.store(key, *cached_entry);
+      return std::move(cached_entry->value);
+    }
+
+    count(&CacheStatistics::misses);
+    auto value = detail::take_fetched_value(std::move(result), key);
+    cache.store(key, DiskCacheEntry<Value>{value, std::move(result.validators), now});
+    return value;
+  }
+
+  /**
+   * Return the stored value of key, even if its time to live expired (e.g. to show it until it is revalidated)
+   * @tparam Value CountryData or CountryListObject
+   */
+  template <typename Value>
+  std::optional<Value> get_cached(std::string const& key) const
+  {
+    auto cached_entry = cache.template load<Value>(key);
+    if (!cached_entry.has_value())
+    {
+      return std::nullopt;
+    }
+    return std::move(cached_entry->value);
+  }
+
+  /**
+   * Return the usage counters
+   */
+  CacheStatistics statistics() const
+  {
+    std::lock_guard<std::mutex> const lock{state->mutex};
+    return state->statistics;
+  }
+
+  /**
+   * Return the underlying disk cache
+   */
+  DiskCache const& disk_cache() const noexcept
+  {
+    return cache;
+  }
+
+private:
+  struct State
+  {
+    std::mutex mutex{};
+    CacheStatistics statistics{};
+  };
+
+  void count(std::size_t CacheStatistics::*counter)
+  {
+    std::lock_guard<std::mutex> const lock{state->mutex};
+    ++(state->statistics.*counter);
+  }
+
+  DiskCache cache;
+  std::chrono::seconds time_to_live;
+  std::shared_ptr<State> state;
+};
+
+} // namespace coronan
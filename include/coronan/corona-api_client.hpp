@@ -1,12 +1,31 @@
 #pragma once
 
+#include "coronan/cancellation.hpp"
+#include "coronan/corona-api_cache_policy.hpp"
 #include "coronan/corona-api_parser.hpp"
+#include "coronan/http_archive.hpp"
 #include "coronan/http_client.hpp"
 #include "coronan/ssl_client.hpp"
+#include "coronan/thread_pool.hpp"
 
+#if defined(__cpp_impl_coroutine)
+#include "coronan/coroutine.hpp"
+#endif
+
+#include <Poco/Net/HTTPClientSession.h>
 #include <Poco/Net/HTTPRequest.h>
 #include <Poco/Net/HTTPSClientSession.h>
+#include <algorithm>
+#include <functional>
+#include <future>
+#include <ios>
+#include <istream>
+#include <iterator>
+#include <memory>
+#include <optional>
 #include <string>
+#include <type_traits>
+#include <utility>
 #include <vector>
 
 namespace coronan {
@@ -16,14 +35,129 @@ constexpr auto corona_api_url = "https://corona-api.com";
 }
 
 using HTTPClient = HTTPClientType<Poco::Net::HTTPSClientSession, Poco::Net::HTTPRequest, Poco::Net::HTTPResponse>;
+/**
+ * HTTP client without TLS, e.g. for a local stand-in server of the corona-api (see coronan_stub_server)
+ */
+using PlainHTTPClient = HTTPClientType<Poco::Net::HTTPClientSession, Poco::Net::HTTPRequest, Poco::Net::HTTPResponse>;
+/**
+ * HTTPS client recording or replaying its responses (see ArchiveHTTPClientType)
+ */
+using ArchiveHTTPClient = ArchiveHTTPClientType<HTTPClient>;
 
 /**
- * A Client for retrieving data from https://corona-api.com.
+ * Error of a single country request of a bulk request
+ */
+struct CountryRequestError
+{
+  std::string country_code{}; /**< ISO 3166-1 alpha-2 Country Code of the failed request */
+  std::string message{};      /**< error message */
+};
+
+/**
+ * Result of a bulk request
  */
+struct BulkCountryData
+{
+  std::vector<CountryData> country_data{};     /**< data of the successful requests (in request order) */
+  std::vector<CountryRequestError> errors{}; /**< errors of the failed requests (in request order) */
+};
+
+/**
+ * Completion handler of an asynchronous request. It is called on a thread of the shared ThreadPool with the ready
+ * future of the request, i.e. future.get() returns the result or throws the error of the request (an
+ * OperationCancelledException if the request was cancelled).
+ */
+template <typename Value>
+using CompletionHandler = std::function<void(std::future<Value>)>;
+
+namespace detail {
+/**
+ * True if ClientType provides a get_streamed(url, body_handler) passing the response body as std::istream&
+ */
+template <typename ClientType, typename = void>
+struct is_streaming_client : std::false_type
+{
+};
+
+template <typename ClientType>
+struct is_streaming_client<ClientType, std::void_t<decltype(ClientType::get_streamed(
+                                           std::declval<std::string const&>(), std::declval<void (*)(std::istream&)>()))>>
+    : std::true_type
+{
+};
+
+/**
+ * True if ClientType provides a get(url, validators) sending a conditional GET
+ */
+template <typename ClientType, typename = void>
+struct is_conditional_client : std::false_type
+{
+};
+
 template <typename ClientType>
+struct is_conditional_client<ClientType, std::void_t<decltype(ClientType::get(
+                                             std::declval<std::string const&>(),
+                                             std::declval<HTTPCacheValidators const&>()))>> : std::true_type
+{
+};
+
+/**
+ * True if ClientType provides a get_streamed(url, body_handler, validators) sending a conditional GET
+ */
+template <typename ClientType, typename = void>
+struct is_conditional_streaming_client : std::false_type
+{
+};
+
+template <typename ClientType>
+struct is_conditional_streaming_client<
+    ClientType, std::void_t<decltype(ClientType::get_streamed(std::declval<std::string const&>(),
+                                                              std::declval<void (*)(std::istream&)>(),
+                                                              std::declval<HTTPCacheValidators const&>()))>>
+    : std::true_type
+{
+};
+} // namespace detail
+
+/**
+ * A Client for retrieving data from https://corona-api.com.
+ *
+ * If the ClientType supports streamed gets (see HTTPClientType::get_streamed) the response body is parsed while it is
+ * received, otherwise the buffered response body is parsed.
+ *
+ * The parsed responses are looked up in and stored to the CachePolicy (keyed by the request url), see NoCachePolicy,
+ * LRUCachePolicy and DiskCachePolicy. If the ClientType supports conditional gets (see HTTPClientType::get) a cache
+ * policy can revalidate a cached response, in which case a HTTP_NOT_MODIFIED response is not parsed at all. A request
+ * whose response body is not valid json (e.g. a truncated body) fails and nothing is cached for it, see
+ * api_parser::ParseException.
+ *
+ * The asynchronous requests (e.g. request_country_data_async) are executed by the shared ThreadPool on a copy of the
+ * client, which shares the cache of the client. They can be cancelled through a CancellationToken: a request which is
+ * cancelled before it starts is not sent at all, a streamed response body stops being received and parsed as soon as
+ * the request is cancelled (its connection is closed) and a buffered response body is not parsed anymore.
+ */
+template <typename ClientType, typename CachePolicy = NoCachePolicy>
 class CoronaAPIClientType
 {
 public:
+  /**
+   * Constructor
+   * @param cache cache policy of the client
+   */
+  explicit CoronaAPIClientType(CachePolicy cache = CachePolicy{}) : cache_policy_{std::move(cache)}
+  {
+  }
+
+  /**
+   * Constructor
+   * @param base_url url of the corona-api, e.g. of a local stand-in server (default: https://corona-api.com)
+   * @param cache cache policy of the client
+   */
+  explicit CoronaAPIClientType(std::string base_url, CachePolicy cache = CachePolicy{})
+      : api_url{std::move(base_url)}, cache_policy_{std::move(cache)}
+  {
+  }
+
   /**
    *  Get the list of available countries
    *  @return List of available countries with Covid-19 case data
@@ -36,50 +170,408 @@ public:
    */
   CountryData request_country_data(std::string_view country_code) const;
 
+  /**
+   * Get the selected fields of the covid-19 case data for a country, e.g. for a view which only shows the latest data
+   * and a timeline metric (fields::latest | fields::timeline::confirmed). The other fields are not parsed and empty.
+   * The projected data is cached separately from the complete data of the country.
+   * @param country_code ISO 3166-1 alpha-2 Country Code
+   * @param fields fields to parse
+   * @return Covid-19 case data for country <country_code>
+   */
+  CountryData request_country_data(std::string_view country_code, FieldSet fields) const;
+
+  /**
+   * Get the covid-19 case data for a list of countries. The countries are requested concurrently by a pool of
+   * max_concurrent_requests threads, i.e. at most max_concurrent_requests requests are in flight at the same time.
+   * A failing request does not abort the other requests but is reported in BulkCountryData::errors.
+   * @param country_codes ISO 3166-1 alpha-2 Country Codes
+   * @param max_concurrent_requests maximum number of concurrent requests
+   * @return Covid-19 case data of the countries and errors of the failed requests
+   */
+  BulkCountryData request_all_country_data(std::vector<std::string> const& country_codes,
+                                           std::size_t max_concurrent_requests = default_max_concurrent_requests) const;
+
+  /**
+   * Get the covid-19 case data for all available countries (see request_countries()).
+   * @param max_concurrent_requests maximum number of concurrent requests
+   * @return Covid-19 case data of the countries and errors of the failed requests
+   */
+  BulkCountryData
+  request_all_country_data(std::size_t max_concurrent_requests = default_max_concurrent_requests) const;
+
+  /**
+   * Return the list of available countries from the cache of the client without a request. Depending on the cache
+   * policy the list may be stale, e.g. to show it at once until a request returned the current list.
+   * @return cached list of available countries, std::nullopt if none is cached
+   */
+  std::optional<std::vector<CountryInfo>> cached_countries() const;
+
+  /**
+   * Return the covid-19 case data for a country from the cache of the client without a request (see
+   * cached_countries())
+   * @param country_code ISO 3166-1 alpha-2 Country Code
+   * @return cached Covid-19 case data for country <country_code>, std::nullopt if none is cached
+   */
+  std::optional<CountryData> cached_country_data(std::string_view country_code) const;
+
+  /**
+   * Get the list of available countries asynchronously
+   * @param cancellation token to cancel the request
+   * @return future of the list of available countries
+   */
+  std::future<std::vector<CountryInfo>> request_countries_async(CancellationToken cancellation = {}) const;
+
+  /**
+   * Get the list of available countries asynchronously
+   * @param on_completion handler called with the result of the request
+   * @param cancellation token to cancel the request
+   */
+  void request_countries_async(CompletionHandler<std::vector<CountryInfo>> on_completion,
+                               CancellationToken cancellation = {}) const;
+
+  /**
+   * Get the covid-19 case data for a country asynchronously
+   * @param country_code ISO 3166-1 alpha-2 Country Code
+   * @param cancellation token to cancel the request, e.g. when the request is superseded by another country
+   * @return future of the Covid-19 case data for country <country_code>
+   */
+  std::future<CountryData> request_country_data_async(std::string_view country_code,
+                                                      CancellationToken cancellation = {}) const;
+
+  /**
+   * Get the covid-19 case data for a country asynchronously
+   * @param country_code ISO 3166-1 alpha-2 Country Code
+   * @param on_completion handler called with the result of the request
+   * @param cancellation token to cancel the request, e.g. when the request is superseded by another country
+   */
+  void request_country_data_async(std::string_view country_code, CompletionHandler<CountryData> on_completion,
+                                  CancellationToken cancellation = {}) const;
+
+#if defined(__cpp_impl_coroutine)
+  /**
+   * Get the list of available countries in a coroutine (C++20 only). The request is started when the result is
+   * awaited and executed like request_countries_async(), i.e. it blocks a thread of the shared ThreadPool while it is
+   * in flight. The awaiting coroutine is suspended until the request completed and is resumed on that thread.
+   * @param cancellation token to cancel the request
+   * @return awaitable of the list of available countries
+   */
+  CompletionAwaitable<std::vector<CountryInfo>> co_request_countries(CancellationToken cancellation = {}) const;
+
+  /**
+   * Get the covid-19 case data for a country in a coroutine (C++20 only, see co_request_countries())
+   * @param country_code ISO 3166-1 alpha-2 Country Code
+   * @param cancellation token to cancel the request
+   * @return awaitable of the Covid-19 case data for country <country_code>
+   */
+  CompletionAwaitable<CountryData> co_request_country_data(std::string_view country_code,
+                                                           CancellationToken cancellation = {}) const;
+#endif
+
+  /**
+   * Default number of concurrent requests of request_all_country_data. Matches the default number of sessions per
+   * host of the HTTPSessionPool.
+   */
+  static constexpr std::size_t default_max_concurrent_requests = 8;
+
+  /**
+   * Return the cache policy of the client (e.g. to query the cache statistics)
+   */
+  CachePolicy const& cache_policy() const noexcept
+  {
+    return cache_policy_;
+  }
+
 private:
+  template <typename ParseFunc>
+  auto fetch_and_parse(std::string const& url, ParseFunc&& parse, CancellationToken const& cancellation = {}) const;
+  template <typename ParseFunc>
+  auto fetch_and_parse(std::string const& url, std::string const& cache_key, ParseFunc&& parse,
+                       CancellationToken const& cancellation) const;
+  template <typename ParseFunc>
+  static auto fetch_and_parse_uncached(std::string const& url, HTTPCacheValidators const& validators,
+                                       ParseFunc&& parse, CancellationToken const& cancellation);
+  template <typename ParseFunc>
+  auto fetch_and_parse_async(std::string url, ParseFunc parse, CancellationToken cancellation) const;
+  template <typename ParseFunc, typename Value>
+  void fetch_and_parse_async(std::string url, ParseFunc parse, CompletionHandler<Value> on_completion,
+                             CancellationToken cancellation) const;
+
   std::string const api_url = corona_api_url;
-  std::unique_ptr<SSLClient> ssl_client = SSLClient::create_with_accept_certificate_handler();
+  SSLClient const* ssl_client = &SSLClient::shared_with_accept_certificate_handler(); // initializes the SSL runtime
+  mutable CachePolicy cache_policy_;
 };
 
 using CoronaAPIClient = CoronaAPIClientType<HTTPClient>;
+using CachedCoronaAPIClient = CoronaAPIClientType<HTTPClient, LRUCachePolicy<>>;
+using DiskCachedCoronaAPIClient = CoronaAPIClientType<HTTPClient, DiskCachePolicy<>>;
 
 namespace {
+constexpr auto parse_countries_json = [](auto& json) { return coronan::api_parser::parse_countries(json); };
+constexpr auto parse_country_json = [](auto& json) { return coronan::api_parser::parse_country(json); };
+
 constexpr auto create_exception_msg = [](auto const& url, auto const& response) {
   return std::string{"Error fetching data from url \""} + url + std::string{"\".\n\n Response status: "} +
          response.reason() + std::string{" ("} + std::to_string(response.status()) + std::string{")."};
 };
 }
 
-template <typename ClientType>
-std::vector<CountryInfo> CoronaAPIClientType<ClientType>::request_countries() const
+template <typename ClientType, typename CachePolicy>
+template <typename ParseFunc>
+auto CoronaAPIClientType<ClientType, CachePolicy>::fetch_and_parse(std::string const& url, ParseFunc&& parse,
+                                                                   CancellationToken const& cancellation) const
 {
-  auto const countries_url = api_url + std::string{"/countries"};
-  auto const http_response = ClientType::get(countries_url);
-  if (http_response.status() == Poco::Net::HTTPResponse::HTTP_OK)
+  return fetch_and_parse(url, url, std::forward<ParseFunc>(parse), cancellation);
+}
+
+// Cache the parsed response under cache_key instead of the url, e.g. if it is parsed differently than usual
+template <typename ClientType, typename CachePolicy>
+template <typename ParseFunc>
+auto CoronaAPIClientType<ClientType, CachePolicy>::fetch_and_parse(std::string const& url,
+                                                                   std::string const& cache_key, ParseFunc&& parse,
+                                                                   CancellationToken const& cancellation) const
+{
+  return cache_policy_.get_or_fetch(cache_key, [&url, &parse, &cancellation](HTTPCacheValidators const& validators) {
+    cancellation.throw_if_cancelled();
+    return fetch_and_parse_uncached(url, validators, parse, cancellation);
+  });
+}
+
+template <typename ClientType, typename CachePolicy>
+template <typename ParseFunc>
+auto CoronaAPIClientType<ClientType, CachePolicy>::fetch_and_parse_async(std::string url, ParseFunc parse,
+                                                                         CancellationToken cancellation) const
+{
+  return ThreadPool::shared().submit(
+      [client = *this, url = std::move(url), parse, cancellation = std::move(cancellation)]() {
+        cancellation.throw_if_cancelled();
+        return client.fetch_and_parse(url, parse, cancellation);
+      });
+}
+
+template <typename ClientType, typename CachePolicy>
+template <typename ParseFunc, typename Value>
+void CoronaAPIClientType<ClientType, CachePolicy>::fetch_and_parse_async(std::string url, ParseFunc parse,
+                                                                         CompletionHandler<Value> on_completion,
+                                                                         CancellationToken cancellation) const
+{
+  ThreadPool::shared().submit([client = *this, url = std::move(url), parse, on_completion = std::move(on_completion),
+                               cancellation = std::move(cancellation)]() {
+    std::packaged_task<Value()> request{[&]() {
+      cancellation.throw_if_cancelled();
+      return client.fetch_and_parse(url, parse, cancellation);
+    }};
+    request();
+    on_completion(request.get_future());
+  });
+}
+
+template <typename ClientType, typename CachePolicy>
+template <typename ParseFunc>
+auto CoronaAPIClientType<ClientType, CachePolicy>::fetch_and_parse_uncached(std::string const& url,
+                                                                           HTTPCacheValidators const& validators,
+                                                                           ParseFunc&& parse,
+                                                                           CancellationToken const& cancellation)
+{
+  if constexpr (detail::is_streaming_client<ClientType>::value)
   {
-    return coronan::api_parser::parse_countries(http_response.response_body());
+    using Value = decltype(parse(std::declval<std::istream&>()));
+    Value parsed_data{};
+    auto const handle_body = [&parsed_data, &parse, &cancellation](std::istream& body) {
+      if (!cancellation.can_be_cancelled())
+      {
+        parsed_data = parse(body);
+        return;
+      }
+      CancellableStreamBuffer cancellable_buffer{body.rdbuf(), cancellation};
+      std::istream cancellable_body{&cancellable_buffer};
+      // Rethrow the OperationCancelledException of the stream buffer instead of failing the stream
+      cancellable_body.exceptions(std::ios::badbit);
+      parsed_data = parse(cancellable_body);
+    };
+    auto const http_response = std::invoke([&]() {
+      if constexpr (detail::is_conditional_streaming_client<ClientType>::value)
+      {
+        return ClientType::get_streamed(url, handle_body, validators);
+      }
+      else
+      {
+        return ClientType::get_streamed(url, handle_body);
+      }
+    });
+    if (http_response.status() == Poco::Net::HTTPResponse::HTTP_NOT_MODIFIED)
+    {
+      return FetchResult<Value>{std::nullopt, http_response.cache_validators()};
+    }
+    if (http_response.status() != Poco::Net::HTTPResponse::HTTP_OK)
+    {
+      throw HTTPClientException{create_exception_msg(url, http_response)};
+    }
+    return FetchResult<Value>{std::move(parsed_data), http_response.cache_validators()};
   }
   else
   {
-    auto const exception_msg = create_exception_msg(countries_url, http_response);
-    throw HTTPClientException{exception_msg};
+    using Value = decltype(parse(std::declval<std::string const&>()));
+    auto const http_response = std::invoke([&]() {
+      if constexpr (detail::is_conditional_client<ClientType>::value)
+      {
+        return ClientType::get(url, validators);
+      }
+      else
+      {
+        return ClientType::get(url);
+      }
+    });
+    if (http_response.status() == Poco::Net::HTTPResponse::HTTP_NOT_MODIFIED)
+    {
+      return FetchResult<Value>{std::nullopt, http_response.cache_validators()};
+    }
+    if (http_response.status() != Poco::Net::HTTPResponse::HTTP_OK)
+    {
+      throw HTTPClientException{create_exception_msg(url, http_response)};
+    }
+    cancellation.throw_if_cancelled();
+    return FetchResult<Value>{parse(http_response.response_body()), http_response.cache_validators()};
   }
 }
 
-template <typename ClientType>
-CountryData CoronaAPIClientType<ClientType>::request_country_data(std::string_view country_code) const
+template <typename ClientType, typename CachePolicy>
+std::vector<CountryInfo> CoronaAPIClientType<ClientType, CachePolicy>::request_countries() const
+{
+  auto const countries_url = api_url + std::string{"/countries"};
+  return fetch_and_parse(countries_url, parse_countries_json);
+}
+
+template <typename ClientType, typename CachePolicy>
+CountryData CoronaAPIClientType<ClientType, CachePolicy>::request_country_data(std::string_view country_code) const
 {
   auto const country_url = api_url + std::string{"/countries/"} + std::string{country_code};
-  auto const http_response = ClientType::get(country_url);
-  if (http_response.status() == Poco::Net::HTTPResponse::HTTP_OK)
+  return fetch_and_parse(country_url, parse_country_json);
+}
 
+template <typename ClientType, typename CachePolicy>
+CountryData CoronaAPIClientType<ClientType, CachePolicy>::request_country_data(std::string_view country_code,
+                                                                              FieldSet fields) const
+{
+  auto const country_url = api_url + std::string{"/countries/"} + std::string{country_code};
+  if (fields == fields::all)
   {
-    return coronan::api_parser::parse_country(http_response.response_body());
+    return fetch_and_parse(country_url, parse_country_json);
   }
-  else
+  // The fragment keeps the projected data apart from the complete data in the cache, the url is requested without it
+  auto const cache_key = country_url + std::string{"#fields="} + std::to_string(fields.mask());
+  return fetch_and_parse(country_url, cache_key,
+                         [fields](auto& json) { return coronan::api_parser::parse_country(json, fields); }, {});
+}
+
+template <typename ClientType, typename CachePolicy>
+std::optional<std::vector<CountryInfo>> CoronaAPIClientType<ClientType, CachePolicy>::cached_countries() const
+{
+  return cache_policy_.template get_cached<CountryListObject>(api_url + std::string{"/countries"});
+}
+
+template <typename ClientType, typename CachePolicy>
+std::optional<CountryData>
+CoronaAPIClientType<ClientType, CachePolicy>::cached_country_data(std::string_view country_code) const
+{
+  return cache_policy_.template get_cached<CountryData>(api_url + std::string{"/countries/"} +
+                                                        std::string{country_code});
+}
+
+template <typename ClientType, typename CachePolicy>
+std::future<std::vector<CountryInfo>>
+CoronaAPIClientType<ClientType, CachePolicy>::request_countries_async(CancellationToken cancellation) const
+{
+  return fetch_and_parse_async(api_url + std::string{"/countries"}, parse_countries_json, std::move(cancellation));
+}
+
+template <typename ClientType, typename CachePolicy>
+void CoronaAPIClientType<ClientType, CachePolicy>::request_countries_async(
+    CompletionHandler<std::vector<CountryInfo>> on_completion, CancellationToken cancellation) const
+{
+  fetch_and_parse_async(api_url + std::string{"/countries"}, parse_countries_json, std::move(on_completion),
+                        std::move(cancellation));
+}
+
+template <typename ClientType, typename CachePolicy>
+std::future<CountryData>
+CoronaAPIClientType<ClientType, CachePolicy>::request_country_data_async(std::string_view country_code,
+                                                                         CancellationToken cancellation) const
+{
+  auto country_url = api_url + std::string{"/countries/"} + std::string{country_code};
+  return fetch_and_parse_async(std::move(country_url), parse_country_json, std::move(cancellation));
+}
+
+template <typename ClientType, typename CachePolicy>
+void CoronaAPIClientType<ClientType, CachePolicy>::request_country_data_async(
+    std::string_view country_code, CompletionHandler<CountryData> on_completion, CancellationToken cancellation) const
+{
+  auto country_url = api_url + std::string{"/countries/"} + std::string{country_code};
+  fetch_and_parse_async(std::move(country_url), parse_country_json, std::move(on_completion), std::move(cancellation));
+}
+
+#if defined(__cpp_impl_coroutine)
+template <typename ClientType, typename CachePolicy>
+CompletionAwaitable<std::vector<CountryInfo>>
+CoronaAPIClientType<ClientType, CachePolicy>::co_request_countries(CancellationToken cancellation) const
+{
+  return CompletionAwaitable<std::vector<CountryInfo>>{
+      [client = *this, cancellation = std::move(cancellation)](auto on_completion) {
+        client.request_countries_async(std::move(on_completion), cancellation);
+      }};
+}
+
+template <typename ClientType, typename CachePolicy>
+CompletionAwaitable<CountryData>
+CoronaAPIClientType<ClientType, CachePolicy>::co_request_country_data(std::string_view country_code,
+                                                                      CancellationToken cancellation) const
+{
+  return CompletionAwaitable<CountryData>{[client = *this, country_code = std::string{country_code},
+                                           cancellation = std::move(cancellation)](auto on_completion) {
+    client.request_country_data_async(country_code, std::move(on_completion), cancellation);
+  }};
+}
+#endif
+
+template <typename ClientType, typename CachePolicy>
+BulkCountryData
+CoronaAPIClientType<ClientType, CachePolicy>::request_all_country_data(std::vector<std::string> const& country_codes,
+                                                                       std::size_t max_concurrent_requests) const
+{
+  std::vector<std::future<CountryData>> requests;
+  requests.reserve(country_codes.size());
+  {
+    ThreadPool request_pool{std::min(max_concurrent_requests, country_codes.size())};
+    for (auto const& country_code : country_codes)
+    {
+      requests.push_back(request_pool.submit([this, &country_code]() { return request_country_data(country_code); }));
+    }
+  }
+
+  BulkCountryData bulk_data{};
+  for (std::size_t i = 0; i < requests.size(); ++i)
   {
-    auto const exception_msg = create_exception_msg(country_url, http_response);
-    throw HTTPClientException{exception_msg};
+    try
+    {
+      bulk_data.country_data.push_back(requests[i].get());
+    }
+    catch (std::exception const& ex)
+    {
+      bulk_data.errors.push_back(CountryRequestError{country_codes[i], ex.what()});
+    }
   }
+  return bulk_data;
 }
+
+template <typename ClientType, typename CachePolicy>
+BulkCountryData
+CoronaAPIClientType<ClientType, CachePolicy>::request_all_country_data(std::size_t max_concurrent_requests) const
+{
+  auto const countries = request_countries();
+  std::vector<std::string> country_codes;
+  country_codes.reserve(countries.size());
+  std::transform(cbegin(countries), cend(countries), std::back_inserter(country_codes),
+                 [](auto const& country) { return country.iso_code; });
+  return request_all_country_data(country_codes, max_concurrent_requests);
+}
+
 } // namespace coronan
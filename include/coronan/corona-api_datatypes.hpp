@@ -1,28 +1,49 @@
 #pragma once
 
+#include <algorithm>
+#include <array>
+#include <bitset>
+#include <cstddef>
+#include <cstdint>
+#include <numeric>
 #include <optional>
 #include <string>
+#include <string_view>
 #include <vector>
 
 namespace coronan {
 
-struct CountryInfo
+/**
+ * Country information. String is std::string, or std::string_view for a view into an in-situ parsed json buffer (see
+ * CountryInfoView).
+ */
+template <typename String>
+struct BasicCountryInfo
 {
-  std::string name{};                   /**< Country name */
-  std::string iso_code{};               /**< ISO 3166-1 alpha-2 Country Code , e.g. ch */
+  String name{};                        /**< Country name */
+  String iso_code{};                    /**< ISO 3166-1 alpha-2 Country Code , e.g. ch */
   std::optional<uint32_t> population{}; /**< Country population */
 };
 
+using CountryInfo = BasicCountryInfo<std::string>;
+/**
+ * Country information whose strings are views into an in-situ parsed json buffer (see
+ * api_parser::parse_countries_insitu)
+ */
+using CountryInfoView = BasicCountryInfo<std::string_view>;
+
 /**
- * CountryData hold the covid-19 data of a single country
+ * BasicCountryData hold the covid-19 data of a single country. String is std::string, or std::string_view for a view
+ * into an in-situ parsed json buffer (see CountryDataView).
  */
-struct CountryData
+template <typename String>
+struct BasicCountryData
 {
 
-  CountryInfo info{}; /**< country information (name, code, population) */
+  BasicCountryInfo<String> info{}; /**< country information (name, code, population) */
   struct TodayData
   {
-    std::string date{};                  /**< iso date string */
+    String date{};                       /**< iso date string */
     std::optional<uint32_t> deaths{};    /**< todays death cased */
     std::optional<uint32_t> confirmed{}; /**< todays confirmed cases */
   };
@@ -31,7 +52,7 @@ struct CountryData
 
   struct LatestData
   {
-    std::string date{};                                     /**< iso date string (last updated) */
+    String date{};                                          /**< iso date string (last updated) */
     std::optional<uint32_t> deaths{};                       /**< latest number of deaths */
     std::optional<uint32_t> confirmed{};                    /**< latest number of confirmed cases */
     std::optional<uint32_t> recovered{};                    /**< latest number of recovered cases */
@@ -47,7 +68,7 @@ struct CountryData
 
   struct TimelineData
   {
-    std::string date{};                      /**< iso date string  */
+    std::optional<int64_t> date{};           /**< seconds since epoch (UTC), see iso_date::parse_seconds */
     std::optional<uint32_t> deaths{};        /**< number of deaths */
     std::optional<uint32_t> confirmed{};     /**< number of confirmed cases */
     std::optional<uint32_t> active{};        /**< number of current covid-19 cases */
@@ -60,6 +81,313 @@ struct CountryData
   std::vector<TimelineData> timeline{}; /**< array of (daily) data */
 };
 
+using CountryData = BasicCountryData<std::string>;
+/**
+ * Covid-19 data of a country whose strings are views into an in-situ parsed json buffer (see
+ * api_parser::parse_country_insitu)
+ */
+using CountryDataView = BasicCountryData<std::string_view>;
+
+/**
+ * A set of fields of BasicCountryData to parse (a projection), e.g. fields::latest | fields::timeline::confirmed. The
+ * parsers skip the json members of the fields which are not in the set, these fields keep their default (empty) value.
+ */
+class FieldSet
+{
+public:
+  constexpr FieldSet() noexcept = default;
+
+  /**
+   * Constructor
+   * @param bits_ bit mask of the fields
+   */
+  constexpr explicit FieldSet(uint32_t bits_) noexcept : bits{bits_}
+  {
+  }
+
+  /**
+   * Return true if all fields of other are in this set (i.e. also if other is empty)
+   */
+  constexpr bool contains(FieldSet other) const noexcept
+  {
+    return (bits & other.bits) == other.bits;
+  }
+
+  /**
+   * Return true if any field of other is in this set
+   */
+  constexpr bool intersects(FieldSet other) const noexcept
+  {
+    return (bits & other.bits) != 0;
+  }
+
+  /**
+   * Return the bit mask of the fields
+   */
+  constexpr uint32_t mask() const noexcept
+  {
+    return bits;
+  }
+
+  friend constexpr FieldSet operator|(FieldSet lhs, FieldSet rhs) noexcept
+  {
+    return FieldSet{lhs.bits | rhs.bits};
+  }
+
+  friend constexpr bool operator==(FieldSet lhs, FieldSet rhs) noexcept
+  {
+    return lhs.bits == rhs.bits;
+  }
+
+  friend constexpr bool operator!=(FieldSet lhs, FieldSet rhs) noexcept
+  {
+    return lhs.bits != rhs.bits;
+  }
+
+private:
+  uint32_t bits{};
+};
+
+/**
+ * The fields of BasicCountryData (see FieldSet)
+ */
+namespace fields {
+
+constexpr FieldSet info{1U << 0U};   /**< info (name, code and population) */
+constexpr FieldSet today{1U << 1U};  /**< today, including its date */
+constexpr FieldSet latest{1U << 2U}; /**< latest, including the calculated values and its date */
+
+/**
+ * The metrics of the timeline points. The date of the points is parsed if any metric is selected.
+ */
+namespace timeline {
+constexpr FieldSet deaths{1U << 3U};        /**< TimelineData::deaths */
+constexpr FieldSet confirmed{1U << 4U};     /**< TimelineData::confirmed */
+constexpr FieldSet active{1U << 5U};        /**< TimelineData::active */
+constexpr FieldSet recovered{1U << 6U};     /**< TimelineData::recovered */
+constexpr FieldSet new_deaths{1U << 7U};    /**< TimelineData::new_deaths */
+constexpr FieldSet new_confirmed{1U << 8U}; /**< TimelineData::new_confirmed */
+constexpr FieldSet new_recovered{1U << 9U}; /**< TimelineData::new_recovered */
+constexpr FieldSet all =
+    deaths | confirmed | active | recovered | new_deaths | new_confirmed | new_recovered; /**< all metrics */
+} // namespace timeline
+
+constexpr FieldSet all = info | today | latest | timeline::all; /**< all fields */
+
+} // namespace fields
+
 using CountryListObject = std::vector<CountryInfo>;
+/**
+ * List of country information whose strings are views into an in-situ parsed json buffer
+ */
+using CountryListView = std::vector<CountryInfoView>;
+
+/**
+ * Columnar (struct of arrays) storage of a country timeline, an alternative to CountryData::timeline.
+ *
+ * Every metric is stored in a contiguous uint32_t column with a packed validity bitmap, a missing value is stored as
+ * 0 and marked invalid. The dates are stored as days since 1970-01-01 (see iso_date::parse_days). Scans over a metric
+ * (e.g. sum or max) are therefore tight loops over a single column.
+ */
+class Timeline
+{
+public:
+  /**
+   * The metrics of a timeline point (see CountryData::TimelineData)
+   */
+  enum class Metric
+  {
+    deaths,
+    confirmed,
+    active,
+    recovered,
+    new_deaths,
+    new_confirmed,
+    new_recovered
+  };
+
+  static constexpr std::size_t metric_count = 7; /**< number of metrics */
+
+  /**
+   * Return the number of points
+   */
+  std::size_t size() const noexcept
+  {
+    return dates.size();
+  }
+
+  /**
+   * Return true if the timeline has no points
+   */
+  bool empty() const noexcept
+  {
+    return dates.empty();
+  }
+
+  /**
+   * Reserve storage for point_count points
+   */
+  void reserve(std::size_t point_count)
+  {
+    auto const word_count = (point_count + bits_per_word - 1) / bits_per_word;
+    dates.reserve(point_count);
+    date_validity.reserve(word_count);
+    for (auto& column : columns)
+    {
+      column.values.reserve(point_count);
+      column.validity.reserve(word_count);
+    }
+  }
+
+  /**
+   * Remove all points
+   */
+  void clear() noexcept
+  {
+    dates.clear();
+    date_validity.clear();
+    for (auto& column : columns)
+    {
+      column.values.clear();
+      column.validity.clear();
+    }
+  }
+
+  /**
+   * Append a point with all metrics missing
+   * @param epoch_day date of the point in days since 1970-01-01, std::nullopt if unknown
+   */
+  void push_back(std::optional<int32_t> epoch_day)
+  {
+    auto const index = size();
+    if (index % bits_per_word == 0)
+    {
+      date_validity.push_back(0);
+      for (auto& column : columns)
+      {
+        column.validity.push_back(0);
+      }
+    }
+    dates.push_back(epoch_day.value_or(0));
+    if (epoch_day.has_value())
+    {
+      set_bit(date_validity, index);
+    }
+    for (auto& column : columns)
+    {
+      column.values.push_back(0);
+    }
+  }
+
+  /**
+   * Set a metric of the point at index
+   */
+  void set(std::size_t index, Metric metric, uint32_t value)
+  {
+    auto& column = column_of(metric);
+    column.values[index] = value;
+    set_bit(column.validity, index);
+  }
+
+  /**
+   * Return the date of the point at index in days since 1970-01-01, std::nullopt if unknown
+   */
+  std::optional<int32_t> date(std::size_t index) const
+  {
+    return test_bit(date_validity, index) ? std::optional<int32_t>{dates[index]} : std::nullopt;
+  }
+
+  /**
+   * Return a metric of the point at index, std::nullopt if missing
+   */
+  std::optional<uint32_t> value(std::size_t index, Metric metric) const
+  {
+    auto const& column = column_of(metric);
+    return test_bit(column.validity, index) ? std::optional<uint32_t>{column.values[index]} : std::nullopt;
+  }
+
+  /**
+   * Return the values of a metric (missing values are 0)
+   */
+  std::vector<uint32_t> const& values(Metric metric) const noexcept
+  {
+    return column_of(metric).values;
+  }
+
+  /**
+   * Return the dates in days since 1970-01-01 (unknown dates are 0)
+   */
+  std::vector<int32_t> const& epoch_days() const noexcept
+  {
+    return dates;
+  }
+
+  /**
+   * Return the number of points with a value for metric
+   */
+  std::size_t count(Metric metric) const noexcept
+  {
+    auto const& validity = column_of(metric).validity;
+    return std::accumulate(cbegin(validity), cend(validity), std::size_t{0},
+                           [](auto count, auto word) { return count + std::bitset<bits_per_word>{word}.count(); });
+  }
+
+  /**
+   * Return the sum of the values of metric
+   */
+  uint64_t sum(Metric metric) const noexcept
+  {
+    auto const& values = column_of(metric).values;
+    return std::accumulate(cbegin(values), cend(values), uint64_t{0});
+  }
+
+  /**
+   * Return the maximum value of metric, std::nullopt if no point has a value for metric
+   */
+  std::optional<uint32_t> max(Metric metric) const noexcept
+  {
+    auto const& column = column_of(metric);
+    if (std::all_of(cbegin(column.validity), cend(column.validity), [](auto word) { return word == 0; }))
+    {
+      return std::nullopt;
+    }
+    // missing values are 0, i.e. they never exceed a value
+    return *std::max_element(cbegin(column.values), cend(column.values));
+  }
+
+private:
+  static constexpr std::size_t bits_per_word = 64;
+  using Bitmap = std::vector<uint64_t>;
+
+  struct Column
+  {
+    std::vector<uint32_t> values{};
+    Bitmap validity{};
+  };
+
+  static void set_bit(Bitmap& bitmap, std::size_t index) noexcept
+  {
+    bitmap[index / bits_per_word] |= uint64_t{1} << (index % bits_per_word);
+  }
+
+  static bool test_bit(Bitmap const& bitmap, std::size_t index) noexcept
+  {
+    return ((bitmap[index / bits_per_word] >> (index % bits_per_word)) & 1U) != 0;
+  }
+
+  Column& column_of(Metric metric) noexcept
+  {
+    return columns[static_cast<std::size_t>(metric)];
+  }
+
+  Column const& column_of(Metric metric) const noexcept
+  {
+    return columns[static_cast<std::size_t>(metric)];
+  }
+
+  std::vector<int32_t> dates{};
+  Bitmap date_validity{};
+  std::array<Column, metric_count> columns{};
+};
 
 } // namespace coronan
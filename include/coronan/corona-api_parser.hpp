@@ -1,29 +1,252 @@
 #pragma once
 
 #include "coronan/corona-api_datatypes.hpp"
+#include "coronan/document_arena.hpp"
 
+#include <cstddef>
+#include <exception>
+#include <iosfwd>
+#include <memory>
 #include <optional>
 #include <string>
+#include <utility>
 #include <vector>
 
 namespace coronan {
 
 namespace api_parser {
+
+/**
+ * A ParseException is thrown by all parser engines if the json is invalid, e.g. a truncated response body. The
+ * simdjson engine validates the structure of the whole json but only the values it reads, i.e. a malformed value of a
+ * member which is skipped is not detected.
+ */
+class ParseException : public std::exception
+{
+public:
+  /**
+   * Constructor
+   * @param error description of the parse error
+   * @param offset offset of the parse error in the json
+   */
+  ParseException(std::string const& error, std::size_t offset);
+  ParseException(ParseException const&) = delete;
+  char const* what() const noexcept override;
+
+  /**
+   * Return the offset of the parse error in the json
+   */
+  std::size_t offset() const noexcept;
+
+private:
+  std::string const msg{};
+  std::size_t const offset_{};
+};
+
+/**
+ * The json parser engine
+ */
+enum class ParserEngine
+{
+  dom,     /**< builds a rapidjson DOM (Document) and reads the values from it */
+  sax,     /**< fills the data directly from the rapidjson SAX (Reader) events without building a DOM */
+  simdjson /**< fills the data while iterating the json with the simdjson On Demand API (see simdjson_implementation) */
+};
+
+/**
+ * Return the name of the simdjson implementation (instruction set) selected for the CPU at runtime, e.g. "haswell",
+ * "westmere" or "arm64". The simdjson engine falls back to the SAX engine (and an empty name is returned) if the
+ * library is built without simdjson (ENABLE_SIMDJSON) or the CPU supports none of the SIMD implementations of
+ * simdjson.
+ */
+std::string simdjson_implementation();
+
+/**
+ * Parse a json string for country data. The DOM engine builds the document in the DocumentArena of the calling
+ * thread.
+ * @param json json string. Must have the format as described at
+ * https://about-corona.net/documentation
+ * @param engine json parser engine to use
+ * @return Parsed Covid-19 case data
+ * @throw ParseException if the json is invalid
+ */
+CountryData parse_country(std::string const& json, ParserEngine engine = ParserEngine::dom);
+
 /**
- * Parse a json string for country data.
+ * Parse the selected fields of a json string for country data. The json members of the other fields are skipped
+ * without being converted, i.e. the other fields of the result are empty.
  * @param json json string. Must have the format as described at
  * https://about-corona.net/documentation
+ * @param fields fields to parse, e.g. fields::latest | fields::timeline::confirmed
+ * @param engine json parser engine to use
  * @return Parsed Covid-19 case data
+ * @throw ParseException if the json is invalid
  */
-CountryData parse_country(std::string const& json);
+CountryData parse_country(std::string const& json, FieldSet fields, ParserEngine engine = ParserEngine::dom);
 
 /**
  * Parse a json string for a list of country information
  * @param json json string. Must have the format as described at
  * https://about-corona.net/documentation
+ * @param engine json parser engine to use
+ * @return Country list parsed
+ * @throw ParseException if the json is invalid
+ */
+CountryListObject parse_countries(std::string const& json, ParserEngine engine = ParserEngine::dom);
+
+/**
+ * Parse the timeline of a json string for country data directly into a columnar Timeline, i.e. without filling
+ * CountryData::timeline.
+ * @param json json string. Must have the format as described at
+ * https://about-corona.net/documentation
+ * @param engine json parser engine to use
+ * @return Parsed Covid-19 case timeline
+ * @throw ParseException if the json is invalid
+ */
+Timeline parse_timeline(std::string const& json, ParserEngine engine = ParserEngine::dom);
+
+/**
+ * Parse a json stream for country data. The stream is read until its end.
+ * @param json_stream json input stream. Must have the format as described at
+ * https://about-corona.net/documentation
+ * @param engine json parser engine to use. The SAX engine parses the data while it is read from the stream, the
+ * simdjson engine reads the whole stream before parsing it.
+ * @return Parsed Covid-19 case data
+ * @throw ParseException if the json is invalid
+ */
+CountryData parse_country(std::istream& json_stream, ParserEngine engine = ParserEngine::sax);
+
+/**
+ * Parse the selected fields of a json stream for country data (see parse_country(std::string const&, FieldSet,
+ * ParserEngine)). The stream is read until its end.
+ * @param json_stream json input stream. Must have the format as described at
+ * https://about-corona.net/documentation
+ * @param fields fields to parse, e.g. fields::latest | fields::timeline::confirmed
+ * @param engine json parser engine to use
+ * @return Parsed Covid-19 case data
+ * @throw ParseException if the json is invalid
+ */
+CountryData parse_country(std::istream& json_stream, FieldSet fields, ParserEngine engine = ParserEngine::sax);
+
+/**
+ * Parse a json stream for a list of country information. The stream is read until its end.
+ * @param json_stream json input stream. Must have the format as described at
+ * https://about-corona.net/documentation
+ * @param engine json parser engine to use. The SAX engine parses the data while it is read from the stream, the
+ * simdjson engine reads the whole stream before parsing it.
+ * @return Country list parsed
+ * @throw ParseException if the json is invalid
+ */
+CountryListObject parse_countries(std::istream& json_stream, ParserEngine engine = ParserEngine::sax);
+
+/**
+ * Parse the timeline of a json stream for country data directly into a columnar Timeline. The stream is read until
+ * its end.
+ * @param json_stream json input stream. Must have the format as described at
+ * https://about-corona.net/documentation
+ * @param engine json parser engine to use. The SAX engine parses the data while it is read from the stream, the
+ * simdjson engine reads the whole stream before parsing it.
+ * @return Parsed Covid-19 case timeline
+ * @throw ParseException if the json is invalid
+ */
+Timeline parse_timeline(std::istream& json_stream, ParserEngine engine = ParserEngine::sax);
+
+/**
+ * Parse (the selected fields of) a json string for country data with the DOM engine, building the document in arena
+ */
+CountryData parse_country(std::string const& json, DocumentArena& arena, FieldSet fields = fields::all);
+
+/**
+ * Parse a json string for a list of country information with the DOM engine, building the document in arena
+ */
+CountryListObject parse_countries(std::string const& json, DocumentArena& arena);
+
+/**
+ * Parse the timeline of a json string for country data with the DOM engine, building the document in arena
+ */
+Timeline parse_timeline(std::string const& json, DocumentArena& arena);
+
+/**
+ * Parse (the selected fields of) a json stream for country data with the DOM engine, building the document in arena
+ */
+CountryData parse_country(std::istream& json_stream, DocumentArena& arena, FieldSet fields = fields::all);
+
+/**
+ * Parse a json stream for a list of country information with the DOM engine, building the document in arena
+ */
+CountryListObject parse_countries(std::istream& json_stream, DocumentArena& arena);
+
+/**
+ * Parse the timeline of a json stream for country data with the DOM engine, building the document in arena
+ */
+Timeline parse_timeline(std::istream& json_stream, DocumentArena& arena);
+
+/**
+ * A view parsed in-situ from a json buffer which it owns, i.e. the strings of the view point into the buffer and are
+ * valid as long as the InsituParsed lives (moving it keeps them valid).
+ */
+template <typename View>
+class InsituParsed
+{
+public:
+  /**
+   * Constructor
+   * @param json_buffer in-situ parsed json buffer
+   * @param view view whose strings point into json_buffer
+   */
+  InsituParsed(std::unique_ptr<std::string> json_buffer, View view)
+      : buffer{std::move(json_buffer)}, view_{std::move(view)}
+  {
+  }
+
+  /**
+   * Return the parsed view
+   */
+  View const& view() const noexcept
+  {
+    return view_;
+  }
+
+  View const* operator->() const noexcept
+  {
+    return &view_;
+  }
+
+private:
+  std::unique_ptr<std::string> buffer;
+  View view_;
+};
+
+/**
+ * Parse a json buffer for country data in-situ with the DOM engine, i.e. without copying the strings: they are
+ * decoded within the buffer and the strings of the returned view point into it. A string member whose value is a
+ * number is returned as empty string.
+ * @param json_buffer null terminated json buffer, owned by the caller. It is modified and must outlive the view.
+ * @param arena arena to build the document in
+ * @return Parsed Covid-19 case data
+ * @throw ParseException if the json is invalid
+ */
+CountryDataView parse_country_insitu(char* json_buffer, DocumentArena& arena = DocumentArena::this_thread());
+
+/**
+ * Parse a json buffer for a list of country information in-situ with the DOM engine (see parse_country_insitu)
+ * @param json_buffer null terminated json buffer, owned by the caller. It is modified and must outlive the view.
+ * @param arena arena to build the document in
  * @return Country list parsed
+ * @throw ParseException if the json is invalid
+ */
+CountryListView parse_countries_insitu(char* json_buffer, DocumentArena& arena = DocumentArena::this_thread());
+
+/**
+ * Take ownership of a json string and parse it in-situ for country data (see parse_country_insitu)
+ */
+InsituParsed<CountryDataView> parse_country_insitu(std::string json);
+
+/**
+ * Take ownership of a json string and parse it in-situ for a list of country information (see
+ * parse_countries_insitu)
  */
-CountryListObject parse_countries(std::string const& json);
+InsituParsed<CountryListView> parse_countries_insitu(std::string json);
 } // namespace api_parser
 
 } // namespace coronan
@@ -0,0 +1,318 @@
+#pragma once
+
+#if !defined(__cpp_impl_coroutine)
+#error "The coronan coroutine interface requires C++20 coroutines (configure with -DENABLE_COROUTINES=ON)"
+#endif
+
+#include <atomic>
+#include <coroutine>
+#include <cstddef>
+#include <exception>
+#include <functional>
+#include <future>
+#include <type_traits>
+#include <utility>
+#include <variant>
+#include <vector>
+
+namespace coronan {
+
+/**
+ * Awaitable of an asynchronous operation which reports its result to a completion handler called with the ready
+ * future of the result (see CoronaAPIClientType::request_country_data_async). The operation is started
+ * when the awaitable is awaited, the awaiting coroutine is resumed on the thread calling the completion handler.
+ */
+template <typename Value>
+class CompletionAwaitable
+{
+public:
+  /**
+   * Callable starting the operation with the given completion handler
+   */
+  using StartOperation = std::function<void(std::function<void(std::future<Value>)>)>;
+
+  explicit CompletionAwaitable(StartOperation start) : start_operation{std::move(start)}
+  {
+  }
+
+  bool await_ready() const noexcept
+  {
+    return false;
+  }
+
+  void await_suspend(std::coroutine_handle<> awaiting)
+  {
+    // The handler may resume (and destroy) the awaiting coroutine before start returns, i.e. the members of the
+    // awaitable must not be used after the operation was started
+    auto const start = std::move(start_operation);
+    start([this, awaiting](std::future<Value> completed) {
+      result = std::move(completed);
+      awaiting.resume();
+    });
+  }
+
+  Value await_resume()
+  {
+    return result.get();
+  }
+
+private:
+  StartOperation start_operation;
+  std::future<Value> result{};
+};
+
+/**
+ * A lazily started coroutine returning a Value. The coroutine starts when the task is awaited (see when_all and
+ * sync_wait to await it from outside of a coroutine), the awaiting coroutine is resumed when the task finished.
+ */
+template <typename Value>
+class Task
+{
+  static_assert(!std::is_void_v<Value>, "Task requires a result value");
+
+public:
+  struct promise_type
+  {
+    Task get_return_object() noexcept
+    {
+      return Task{std::coroutine_handle<promise_type>::from_promise(*this)};
+    }
+
+    std::suspend_always initial_suspend() const noexcept
+    {
+      return {};
+    }
+
+    auto final_suspend() const noexcept
+    {
+      struct ResumeContinuation
+      {
+        bool await_ready() const noexcept
+        {
+          return false;
+        }
+        std::coroutine_handle<> await_suspend(std::coroutine_handle<promise_type> finished) const noexcept
+        {
+          return finished.promise().continuation;
+        }
+        void await_resume() const noexcept
+        {
+        }
+      };
+      return ResumeContinuation{};
+    }
+
+    template <typename Result>
+    void return_value(Result&& value)
+    {
+      result.template emplace<1>(std::forward<Result>(value));
+    }
+
+    void unhandled_exception() noexcept
+    {
+      result.template emplace<2>(std::current_exception());
+    }
+
+    std::coroutine_handle<> continuation = std::noop_coroutine();
+    std::variant<std::monostate, Value, std::exception_ptr> result{};
+  };
+
+  Task(Task&& other) noexcept : coroutine{std::exchange(other.coroutine, nullptr)}
+  {
+  }
+  Task& operator=(Task&& other) noexcept
+  {
+    if (this != &other)
+    {
+      destroy();
+      coroutine = std::exchange(other.coroutine, nullptr);
+    }
+    return *this;
+  }
+  Task(Task const&) = delete;
+  Task& operator=(Task const&) = delete;
+  ~Task()
+  {
+    destroy();
+  }
+
+  auto operator co_await() && noexcept
+  {
+    struct TaskAwaiter
+    {
+      bool await_ready() const noexcept
+      {
+        return coroutine.done();
+      }
+      std::coroutine_handle<> await_suspend(std::coroutine_handle<> awaiting) const noexcept
+      {
+        coroutine.promise().continuation = awaiting;
+        return coroutine;
+      }
+      Value await_resume() const
+      {
+        auto& result = coroutine.promise().result;
+        if (result.index() == 2)
+        {
+          std::rethrow_exception(std::get<2>(result));
+        }
+        return std::move(std::get<1>(result));
+      }
+
+      std::coroutine_handle<promise_type> coroutine;
+    };
+    return TaskAwaiter{coroutine};
+  }
+
+private:
+  explicit Task(std::coroutine_handle<promise_type> handle) noexcept : coroutine{handle}
+  {
+  }
+
+  void destroy() noexcept
+  {
+    if (coroutine)
+    {
+      coroutine.destroy();
+    }
+  }
+
+  std::coroutine_handle<promise_type> coroutine;
+};
+
+namespace detail {
+/**
+ * A coroutine which starts immediately and destroys itself when it finished
+ */
+struct DetachedCoroutine
+{
+  struct promise_type
+  {
+    DetachedCoroutine get_return_object() const noexcept
+    {
+      return {};
+    }
+    std::suspend_never initial_suspend() const noexcept
+    {
+      return {};
+    }
+    std::suspend_never final_suspend() const noexcept
+    {
+      return {};
+    }
+    void return_void() const noexcept
+    {
+    }
+    void unhandled_exception() const noexcept
+    {
+      std::terminate();
+    }
+  };
+};
+
+template <typename Value>
+DetachedCoroutine complete_promise(Task<Value>& task, std::promise<Value>& result, std::function<void()> on_completion)
+{
+  try
+  {
+    result.set_value(co_await std::move(task));
+  }
+  catch (...)
+  {
+    result.set_exception(std::current_exception());
+  }
+  on_completion();
+}
+
+// Same as complete_promise but the coroutine owns the task and the promise, i.e. setting the result is its last access
+// to anything of the caller and the caller may return as soon as the result is set (while the coroutine frame is
+// still being destroyed)
+template <typename Value>
+DetachedCoroutine complete_owned_promise(Task<Value> task, std::promise<Value> result)
+{
+  try
+  {
+    result.set_value(co_await std::move(task));
+  }
+  catch (...)
+  {
+    result.set_exception(std::current_exception());
+  }
+}
+
+template <typename Value>
+class WhenAllAwaitable
+{
+public:
+  explicit WhenAllAwaitable(std::vector<Task<Value>> tasks_) : tasks{std::move(tasks_)}, results(tasks.size())
+  {
+  }
+
+  bool await_ready() const noexcept
+  {
+    return tasks.empty();
+  }
+
+  bool await_suspend(std::coroutine_handle<> awaiting_)
+  {
+    awaiting = awaiting_;
+    for (std::size_t i = 0; i < tasks.size(); ++i)
+    {
+      complete_promise(tasks[i], results[i], [this]() {
+        if (--remaining == 0)
+        {
+          awaiting.resume();
+        }
+      });
+    }
+    // The awaiting coroutine continues without suspension if all tasks completed synchronously
+    return --remaining != 0;
+  }
+
+  std::vector<std::future<Value>> await_resume()
+  {
+    std::vector<std::future<Value>> futures;
+    futures.reserve(results.size());
+    for (auto& result : results)
+    {
+      futures.push_back(result.get_future());
+    }
+    return futures;
+  }
+
+private:
+  std::vector<Task<Value>> tasks;
+  std::vector<std::promise<Value>> results;
+  std::atomic<std::size_t> remaining{tasks.size() + 1};
+  std::coroutine_handle<> awaiting{};
+};
+} // namespace detail
+
+/**
+ * Start all tasks concurrently and wait until all of them finished
+ * @param tasks tasks to run
+ * @return ready futures of the task results (in task order), i.e. future.get() returns the value or throws the error
+ * of a task
+ */
+template <typename Value>
+Task<std::vector<std::future<Value>>> when_all(std::vector<Task<Value>> tasks)
+{
+  co_return co_await detail::WhenAllAwaitable<Value>{std::move(tasks)};
+}
+
+/**
+ * Run a task and block the calling thread until it finished. Must not be called on a thread which resumes coroutines
+ * (e.g. a thread of the shared ThreadPool).
+ * @param task task to run
+ * @return result of the task (an exception of the task is rethrown)
+ */
+template <typename Value>
+Value sync_wait(Task<Value> task)
+{
+  std::promise<Value> result;
+  auto completed = result.get_future();
+  detail::complete_owned_promise(std::move(task), std::move(result));
+  return completed.get();
+}
+
+} // namespace coronan
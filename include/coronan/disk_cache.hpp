@@ -0,0 +1,73 @@
+#pragma once
+
+#include "coronan/corona-api_datatypes.hpp"
+#include "coronan/http_client.hpp"
+
+#include <chrono>
+#include <optional>
+#include <string>
+
+namespace coronan {
+
+/**
+ * A cached response value together with its cache validators
+ */
+template <typename Value>
+struct DiskCacheEntry
+{
+  Value value{};                    /**< parsed response */
+  HTTPCacheValidators validators{}; /**< cache validators of the response */
+  std::chrono::seconds stored_at{}; /**< time the entry was stored or last revalidated (seconds since epoch) */
+};
+
+/**
+ * A persistent cache of parsed responses (CountryData and CountryListObject) in a directory. Every entry is stored in
+ * its own file named after the (percent-encoded) key, so that the cache can be shared between processes. The key is
+ * stored in the file as well and an entry is only loaded for its own key.
+ *
+ * Failing to read or write a cache file is not an error: load returns std::nullopt and store returns false.
+ */
+class DiskCache
+{
+public:
+  /**
+   * Constructor
+   * @param directory cache directory. Created on the first store if it does not exist.
+   */
+  explicit DiskCache(std::string directory);
+
+  /**
+   * Return the default cache directory (coronan in the user's cache directory, e.g. ~/.cache/coronan)
+   */
+  static std::string default_directory();
+
+  /**
+   * Load the entry of key
+   * @tparam Value CountryData or CountryListObject
+   */
+  template <typename Value>
+  std::optional<DiskCacheEntry<Value>> load(std::string const& key) const;
+
+  /**
+   * Store (or replace) the entry of key
+   * @tparam Value CountryData or CountryListObject
+   * @return true if the entry was written
+   */
+  template <typename Value>
+  bool store(std::string const& key, DiskCacheEntry<Value> const& entry) const;
+
+  /**
+   * Return the cache directory
+   */
+  std::string const& directory() const noexcept;
+
+  /**
+   * Return the path of the cache file of key
+   */
+  std::string file_path(std::string const& key) const;
+
+private:
+  std::string directory_{};
+};
+
+} // namespace coronan
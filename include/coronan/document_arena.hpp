@@ -0,0 +1,73 @@
+#pragma once
+
+#include <cstddef>
+#include <memory>
+
+namespace coronan::api_parser {
+
+/**
+ * Configuration of a DocumentArena
+ */
+struct DocumentArenaConfig
+{
+  std::size_t chunk_capacity{64 * 1024};           /**< initial size of the retained buffer of the json values */
+  std::size_t stack_capacity{16 * 1024};           /**< initial size of the retained buffer of the parse stack */
+  std::size_t max_retained_bytes{4 * 1024 * 1024}; /**< limit of the size of each retained buffer */
+};
+
+/**
+ * DocumentArena counters
+ */
+struct DocumentArenaStatistics
+{
+  std::size_t documents{};           /**< number of json documents parsed in the arena */
+  std::size_t bytes_retained{};      /**< size of the buffers retained for the next document */
+  std::size_t allocations_avoided{}; /**< number of value pools and parse stacks which fitted in a retained buffer */
+};
+
+class DocumentArena;
+
+namespace detail {
+class DocumentArenaState;
+DocumentArenaState& arena_state(DocumentArena& arena) noexcept;
+} // namespace detail
+
+/**
+ * Reusable memory of the json DOM parser engine (see ParserEngine::dom). The json values and the parse stack of a
+ * document are allocated from buffers which are retained for the next document, i.e. parsing documents back-to-back
+ * does not allocate (as long as a document fits into the buffers). A buffer which was too small for a document grows
+ * to the size the document needed, up to DocumentArenaConfig::max_retained_bytes.
+ *
+ * The DOM parser entry points use the arena of the calling thread (see this_thread) unless an arena is passed. An
+ * arena must only be used by one thread at a time.
+ */
+class DocumentArena
+{
+public:
+  explicit DocumentArena(DocumentArenaConfig const& config = DocumentArenaConfig{});
+  ~DocumentArena();
+  DocumentArena(DocumentArena const&) = delete;
+  DocumentArena& operator=(DocumentArena const&) = delete;
+
+  /**
+   * Return the arena of the calling thread
+   */
+  static DocumentArena& this_thread();
+
+  /**
+   * Return the counters of this arena
+   */
+  DocumentArenaStatistics statistics() const noexcept;
+
+  /**
+   * Return the counters summed over all arenas of the process (bytes_retained of the existing arenas)
+   */
+  static DocumentArenaStatistics total_statistics() noexcept;
+
+private:
+  friend detail::DocumentArenaState& detail::arena_state(DocumentArena& arena) noexcept;
+
+  std::unique_ptr<detail::DocumentArenaState> state;
+};
+
+} // namespace coronan::api_parser
@@ -0,0 +1,197 @@
+#pragma once
+
+#include "coronan/http_client.hpp"
+
+#include <Poco/Net/HTTPResponse.h>
+#include <atomic>
+#include <cstddef>
+#include <mutex>
+#include <optional>
+#include <sstream>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace coronan {
+
+/**
+ * A recorded HTTP response
+ */
+struct RecordedResponse
+{
+  Poco::Net::HTTPResponse::HTTPStatus status{Poco::Net::HTTPResponse::HTTP_OK}; /**< HTTP status code */
+  std::string reason{};                                                        /**< HTTP reason phrase */
+  HTTPHeaders headers{};                                                       /**< response headers */
+  std::string body{};                                                          /**< response body */
+};
+
+/**
+ * An archive of recorded HTTP responses keyed by request url, saved to and loaded from a compact binary file.
+ *
+ * Thread safe, i.e. responses of concurrent requests can be recorded.
+ */
+class HTTPArchive
+{
+public:
+  /**
+   * Replace the recorded responses by the ones of an archive file written by save()
+   * @throw HTTPClientException if the file cannot be read or is not an archive file
+   */
+  void load(std::string const& file_path);
+
+  /**
+   * Save the archive to a file
+   * @throw HTTPClientException if the file cannot be written
+   */
+  void save(std::string const& file_path) const;
+
+  /**
+   * Record (or replace) the response of url
+   */
+  void record(std::string const& url, RecordedResponse response);
+
+  /**
+   * Return the recorded response of url or std::nullopt if no response of url was recorded
+   */
+  std::optional<RecordedResponse> find(std::string const& url) const;
+
+  /**
+   * Return the number of recorded responses
+   */
+  std::size_t size() const;
+
+  /**
+   * Remove all recorded responses
+   */
+  void clear();
+
+private:
+  mutable std::mutex mutex{};
+  std::unordered_map<std::string, RecordedResponse> responses{};
+};
+
+/**
+ * Mode of an ArchiveHTTPClientType
+ */
+enum class ArchiveMode
+{
+  pass_through, /**< forward every request to the wrapped client */
+  record,       /**< forward every request to the wrapped client and record its response in the archive */
+  replay        /**< answer every request with the recorded response of the archive, without touching the network */
+};
+
+/**
+ * A HTTP client recording the responses of the wrapped ClientType in a HTTPArchive or replaying them from it, e.g.
+ * for reproducible performance baselines and offline runs from a snapshot. Plugs in as ClientType of
+ * CoronaAPIClientType.
+ *
+ * Cache validators are only forwarded in pass_through mode, so that the archive always holds complete responses.
+ * ClientType must provide a get(url, validators) (see HTTPClientType::get) and, if get_streamed() is used, a
+ * get_streamed(url, body_handler, validators) (see HTTPClientType::get_streamed).
+ */
+template <typename ClientType>
+struct ArchiveHTTPClientType
+{
+  /**
+   * Execute a HTTP GET according to the mode()
+   * @throw HTTPClientException in replay mode if no response of url was recorded
+   */
+  static HTTPResponse get(std::string const& url, HTTPCacheValidators const& validators = {});
+
+  /**
+   * Execute a HTTP GET according to the mode() and pass the body of a HTTP_OK response to handle_body. The body is
+   * streamed by the wrapped client in pass_through mode. Recorded and replayed bodies are complete responses and are
+   * passed to handle_body once they were received.
+   * @throw HTTPClientException in replay mode if no response of url was recorded
+   */
+  template <typename BodyHandler>
+  static HTTPResponse get_streamed(std::string const& url, BodyHandler&& handle_body,
+                                   HTTPCacheValidators const& validators = {});
+
+  /**
+   * Return the archive of the recorded responses
+   */
+  static HTTPArchive& archive();
+
+  /**
+   * Set the mode (default: ArchiveMode::pass_through)
+   */
+  static void set_mode(ArchiveMode mode) noexcept;
+
+  /**
+   * Return the mode
+   */
+  static ArchiveMode mode() noexcept;
+
+private:
+  inline static std::atomic<ArchiveMode> mode_{ArchiveMode::pass_through};
+};
+
+template <typename ClientType>
+HTTPResponse ArchiveHTTPClientType<ClientType>::get(std::string const& url, HTTPCacheValidators const& validators)
+{
+  switch (mode())
+  {
+  case ArchiveMode::record: {
+    auto response = ClientType::get(url);
+    archive().record(url, RecordedResponse{response.status(), response.reason(), response.headers(),
+                                           response.response_body()});
+    return response;
+  }
+  case ArchiveMode::replay: {
+    auto const recorded = archive().find(url);
+    if (!recorded.has_value())
+    {
+      throw HTTPClientException{std::string{"No recorded response for url \""} + url + "\"."};
+    }
+    Poco::Net::HTTPResponse response{recorded->status, recorded->reason};
+    for (auto const& [name, value] : recorded->headers)
+    {
+      response.add(name, value);
+    }
+    return HTTPResponse{response, recorded->body};
+  }
+  default:
+    return ClientType::get(url, validators);
+  }
+}
+
+template <typename ClientType>
+template <typename BodyHandler>
+HTTPResponse ArchiveHTTPClientType<ClientType>::get_streamed(std::string const& url, BodyHandler&& handle_body,
+                                                             HTTPCacheValidators const& validators)
+{
+  if (mode() == ArchiveMode::pass_through)
+  {
+    return ClientType::get_streamed(url, std::forward<BodyHandler>(handle_body), validators);
+  }
+  auto response = get(url);
+  if (response.status() == Poco::Net::HTTPResponse::HTTP_OK)
+  {
+    std::istringstream body{response.response_body()};
+    handle_body(body);
+  }
+  return response;
+}
+
+template <typename ClientType>
+HTTPArchive& ArchiveHTTPClientType<ClientType>::archive()
+{
+  static HTTPArchive http_archive{};
+  return http_archive;
+}
+
+template <typename ClientType>
+void ArchiveHTTPClientType<ClientType>::set_mode(ArchiveMode mode) noexcept
+{
+  mode_ = mode;
+}
+
+template <typename ClientType>
+ArchiveMode ArchiveHTTPClientType<ClientType>::mode() noexcept
+{
+  return mode_;
+}
+
+} // namespace coronan
@@ -1,11 +1,31 @@
 #pragma once
 
+#include "coronan/cancellation.hpp"
+#include "coronan/http_session_pool.hpp"
+#include "coronan/http_timing.hpp"
+#include "coronan/tls_session_cache.hpp"
+
 #include <Poco/Net/HTTPResponse.h>
+#include <Poco/Net/NetException.h>
+#include <Poco/Net/SSLManager.h>
+#include <Poco/Net/SecureStreamSocket.h>
 #include <Poco/StreamCopier.h>
 #include <Poco/URI.h>
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <exception>
 #include <functional>
+#include <istream>
+#include <limits>
+#include <memory>
+#include <optional>
 #include <stdexcept>
+#include <streambuf>
 #include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
 
 namespace coronan {
 
@@ -23,6 +43,20 @@ private:
   std::string const msg{};
 };
 
+/**
+ * Cache validators of a HTTP response, sent with a conditional GET to revalidate a cached response
+ */
+struct HTTPCacheValidators
+{
+  std::string etag{};          /**< value of the ETag header (sent as If-None-Match) */
+  std::string last_modified{}; /**< value of the Last-Modified header (sent as If-Modified-Since) */
+};
+
+/**
+ * HTTP header fields (name, value) in the order of the message
+ */
+using HTTPHeaders = std::vector<std::pair<std::string, std::string>>;
+
 /**
  * A HTTPResponse containing response status and payload
  */
@@ -33,8 +67,10 @@ public:
    *  Constructor
    * @param response http response
    * @param response_body http response body
+   * @param timings timing breakdown of the request
    */
-  explicit HTTPResponse(Poco::Net::HTTPResponse const& response, std::string response_body);
+  explicit HTTPResponse(Poco::Net::HTTPResponse const& response, std::string response_body,
+                        HTTPTimings const& timings = {});
 
   /**
    * Return the HTTP status code
@@ -49,33 +85,289 @@ public:
   /**
    * Return the HTTP response body
    */
-  std::string response_body() const noexcept;
+  std::string const& response_body() const noexcept;
+
+  /**
+   * Return the ETag and Last-Modified header values of the response (empty if not present)
+   */
+  HTTPCacheValidators cache_validators() const;
+
+  /**
+   * Return the header fields of the response
+   */
+  HTTPHeaders headers() const;
+
+  /**
+   * Return the timing breakdown of the request
+   */
+  HTTPTimings const& timings() const noexcept;
 
 private:
   Poco::Net::HTTPResponse response_{};
   std::string response_body_{};
+  HTTPTimings timings_{};
+};
+
+namespace detail {
+/**
+ * True if SessionType is a HTTPS session providing its TLS session (see Poco::Net::HTTPSClientSession::sslSession)
+ */
+template <typename SessionType, typename = void>
+struct is_tls_session : std::false_type
+{
+};
+
+template <typename SessionType>
+struct is_tls_session<SessionType, std::void_t<decltype(std::declval<SessionType&>().sslSession())>> : std::true_type
+{
+};
+
+/**
+ * True if SessionType tells whether it is connected (see Poco::Net::HTTPSession::connected)
+ */
+template <typename SessionType, typename = void>
+struct has_connection_state : std::false_type
+{
+};
+
+template <typename SessionType>
+struct has_connection_state<SessionType, std::void_t<decltype(std::declval<SessionType const&>().connected())>>
+    : std::true_type
+{
+};
+
+/**
+ * True if SessionType provides the socket implementation of its connection (see Poco::Net::HTTPSession::socket)
+ */
+template <typename SessionType, typename = void>
+struct has_socket_handle : std::false_type
+{
+};
+
+template <typename SessionType>
+struct has_socket_handle<SessionType, std::void_t<decltype(std::declval<SessionType&>().socket().impl()->sockfd())>>
+    : std::true_type
+{
+};
+
+/**
+ * Return the socket implementation and the socket handle of the connection of a session. Poco replaces the socket of a
+ * HTTPS session and reopens the socket of a HTTP session when it reconnects.
+ */
+template <typename SessionType>
+auto socket_handle(SessionType& session)
+{
+  if constexpr (has_socket_handle<SessionType>::value)
+  {
+    auto const* socket = session.socket().impl();
+    return std::make_pair(static_cast<void const*>(socket), socket->sockfd());
+  }
+  else
+  {
+    return std::make_pair(static_cast<void const*>(nullptr), 0);
+  }
+}
+
+/**
+ * A stream buffer reading from another stream buffer and counting the read bytes. Bulk reads are passed through to
+ * the source without copying.
+ */
+class CountingStreamBuffer : public std::streambuf
+{
+public:
+  explicit CountingStreamBuffer(std::streambuf* source) : source_{source}
+  {
+  }
+
+  std::size_t count() const noexcept
+  {
+    return count_;
+  }
+
+protected:
+  int_type underflow() override
+  {
+    auto const read = source_->sgetn(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+    if (read <= 0)
+    {
+      return traits_type::eof();
+    }
+    count_ += static_cast<std::size_t>(read);
+    setg(buffer.data(), buffer.data(), buffer.data() + read);
+    return traits_type::to_int_type(buffer.front());
+  }
+
+  std::streamsize xsgetn(char* destination, std::streamsize size) override
+  {
+    auto const buffered = std::min<std::streamsize>(size, egptr() - gptr());
+    std::copy_n(gptr(), buffered, destination);
+    gbump(static_cast<int>(buffered));
+    if (buffered == size)
+    {
+      return size;
+    }
+    auto const read = source_->sgetn(destination + buffered, size - buffered);
+    count_ += static_cast<std::size_t>(std::max<std::streamsize>(read, 0));
+    return buffered + std::max<std::streamsize>(read, 0);
+  }
+
+private:
+  std::streambuf* source_;
+  std::array<char, 4096> buffer{};
+  std::size_t count_{};
+};
+
+/**
+ * Carries an exception thrown by the body handler of HTTPClientType::get_streamed through execute_get, so that it is
+ * rethrown unchanged instead of being wrapped into a HTTPClientException
+ */
+struct BodyHandlerError
+{
+  std::exception_ptr exception{};
 };
+} // namespace detail
 
 /**
- * Simple Stateless HTTP Client
+ * Simple HTTP Client. Connections are kept alive and reused through a process wide session pool. If no response is
+ * received on a reused connection (i.e. the server closed the idle connection) the request is sent once more on a new
+ * connection.
+ *
+ * Every response carries the timing breakdown of its request (see HTTPResponse::timings), which is also passed to the
+ * timing sink (see set_http_timing_sink).
+ *
+ * For HTTPS sessions the TLS session of the latest handshake with a host is cached, so that a new connection to the
+ * host resumes it with an abbreviated handshake (see TLSSessionCache).
  */
 template <typename SessionType, typename HTTPRequestType, typename HTTPResponseType>
 struct HTTPClientType
 {
   /**
-   * Execute a HTTP GET
+   * Execute a HTTP GET. If cache validators are given a conditional GET is sent, i.e. the server answers with
+   * HTTP_NOT_MODIFIED (and no body) if the resource did not change.
    * @param url GET url
+   * @param validators cache validators of a previous response of url
    */
-  static HTTPResponse get(std::string const& url);
+  static HTTPResponse get(std::string const& url, HTTPCacheValidators const& validators = {});
+
+  /**
+   * Execute a HTTP GET and pass the response body stream to handle_body while it is received, i.e. without
+   * buffering the body. handle_body is only called for a HTTP_OK response, the body of any other response is
+   * returned in the HTTPResponse. An exception thrown by handle_body (e.g. an OperationCancelledException or a parse
+   * error) is passed through unchanged and closes the connection.
+   * @param url GET url
+   * @param handle_body callable taking the response body as std::istream&
+   * @param validators cache validators of a previous response of url (see get())
+   */
+  template <typename BodyHandler>
+  static HTTPResponse get_streamed(std::string const& url, BodyHandler&& handle_body,
+                                   HTTPCacheValidators const& validators = {});
+
+  /**
+   * Return the pool of keep-alive sessions used by get()
+   */
+  static HTTPSessionPool<SessionType>& session_pool();
+
+  /**
+   * Return the cache of TLS sessions used to resume sessions of new HTTPS connections, including the statistics of
+   * full and resumed handshakes. Not used for plain HTTP sessions.
+   */
+  static TLSSessionCache& tls_session_cache();
+
+private:
+  static std::unique_ptr<SessionType> create_session(std::string const& host, std::uint16_t port);
+
+  template <typename BodyReader>
+  static HTTPResponse execute_get(std::string const& url, HTTPCacheValidators const& validators,
+                                  BodyReader&& read_body);
 };
 
+namespace {
+constexpr auto read_to_string = [](std::istream& response_stream) {
+  std::string content;
+  Poco::StreamCopier::copyToString(response_stream, content);
+  return content;
+};
+} // namespace
+
 template <typename SessionType, typename HTTPRequestType, typename HTTPResponseType>
-HTTPResponse HTTPClientType<SessionType, HTTPRequestType, HTTPResponseType>::get(std::string const& url)
+HTTPSessionPool<SessionType>& HTTPClientType<SessionType, HTTPRequestType, HTTPResponseType>::session_pool()
+{
+  static HTTPSessionPool<SessionType> pool{HTTPSessionPoolConfig{}, create_session};
+  return pool;
+}
+
+template <typename SessionType, typename HTTPRequestType, typename HTTPResponseType>
+TLSSessionCache& HTTPClientType<SessionType, HTTPRequestType, HTTPResponseType>::tls_session_cache()
+{
+  static TLSSessionCache cache{};
+  return cache;
+}
+
+template <typename SessionType, typename HTTPRequestType, typename HTTPResponseType>
+std::unique_ptr<SessionType>
+HTTPClientType<SessionType, HTTPRequestType, HTTPResponseType>::create_session(std::string const& host,
+                                                                               std::uint16_t port)
+{
+  if constexpr (detail::is_tls_session<SessionType>::value)
+  {
+    return std::make_unique<SessionType>(host, port, Poco::Net::SSLManager::instance().defaultClientContext(),
+                                         tls_session_cache().get(host, port));
+  }
+  else
+  {
+    return std::make_unique<SessionType>(host, port);
+  }
+}
+
+template <typename SessionType, typename HTTPRequestType, typename HTTPResponseType>
+HTTPResponse HTTPClientType<SessionType, HTTPRequestType, HTTPResponseType>::get(std::string const& url,
+                                                                                HTTPCacheValidators const& validators)
+{
+  return execute_get(url, validators, [](HTTPResponseType const& /*response*/, std::istream& response_stream) {
+    return read_to_string(response_stream);
+  });
+}
+
+template <typename SessionType, typename HTTPRequestType, typename HTTPResponseType>
+template <typename BodyHandler>
+HTTPResponse HTTPClientType<SessionType, HTTPRequestType, HTTPResponseType>::get_streamed(
+    std::string const& url, BodyHandler&& handle_body, HTTPCacheValidators const& validators)
+{
+  return execute_get(url, validators, [&handle_body](HTTPResponseType const& response, std::istream& response_stream) {
+    if (response.getStatus() != Poco::Net::HTTPResponse::HTTP_OK)
+    {
+      return read_to_string(response_stream);
+    }
+    try
+    {
+      handle_body(response_stream);
+    }
+    catch (...)
+    {
+      throw detail::BodyHandlerError{std::current_exception()};
+    }
+    // Skip whatever the handler did not consume, so that the connection can be reused
+    response_stream.ignore(std::numeric_limits<std::streamsize>::max());
+    return std::string{};
+  });
+}
+
+template <typename SessionType, typename HTTPRequestType, typename HTTPResponseType>
+template <typename BodyReader>
+HTTPResponse HTTPClientType<SessionType, HTTPRequestType, HTTPResponseType>::execute_get(
+    std::string const& url, HTTPCacheValidators const& validators, BodyReader&& read_body)
 {
   try
   {
+    using Clock = std::chrono::steady_clock;
+    auto const start_time = Clock::now();
+    HTTPTimings timings{};
+
     Poco::URI const uri{url};
-    SessionType session(uri.getHost(), uri.getPort());
+    std::optional<typename HTTPSessionPool<SessionType>::Lease> session_lease{
+        session_pool().checkout(uri.getHost(), uri.getPort())};
+    auto const checkout_time = Clock::now();
+    timings.checkout = checkout_time - start_time;
 
     auto const path = std::invoke([uri]() {
       auto const path_ = uri.getPathAndQuery();
@@ -83,18 +375,99 @@ HTTPResponse HTTPClientType<SessionType, HTTPRequestType, HTTPResponseType>::get
     });
 
     HTTPRequestType request{"GET", path, "HTTP/1.1"};
+    request.setKeepAlive(true);
+    if (!validators.etag.empty())
+    {
+      request.set("If-None-Match", validators.etag);
+    }
+    if (!validators.last_modified.empty())
+    {
+      request.set("If-Modified-Since", validators.last_modified);
+    }
 
     HTTPResponseType response;
-    session.sendRequest(request);
-    auto& response_stream = session.receiveResponse(response);
+    std::istream* response_stream = nullptr;
+    auto request_sent_time = checkout_time;
+    while (response_stream == nullptr)
+    {
+      auto& session = session_lease->session();
+      session.setKeepAlive(true);
+      auto const connected_before_request = std::invoke([&session]() {
+        if constexpr (detail::has_connection_state<SessionType>::value)
+        {
+          return session.connected();
+        }
+        else
+        {
+          return false;
+        }
+      });
+      auto const socket_before_request = detail::socket_handle(session);
+      try
+      {
+        session.sendRequest(request);
+        request_sent_time = Clock::now();
+        // The session reconnects in sendRequest if it expects the server to have closed the connection (e.g. after
+        // the keep-alive timeout), i.e. the connection is only reused if its socket did not change
+        timings.connection_reused = connected_before_request && detail::socket_handle(session) == socket_before_request;
+        response_stream = &session.receiveResponse(response);
+      }
+      catch (Poco::Net::MessageException const&)
+      {
+        // A (partial) response was received
+        throw;
+      }
+      catch (Poco::Net::NetException const&)
+      {
+        // The server may close an idle keep-alive connection at any time. If nothing was received on a reused session
+        // the request is sent once more on a new session.
+        if (!session_lease->reused())
+        {
+          throw;
+        }
+        session_lease.reset();
+        session_lease.emplace(session_pool().checkout_new(uri.getHost(), uri.getPort()));
+      }
+    }
+    auto& session = session_lease->session();
+    timings.send_request = request_sent_time - checkout_time;
+    auto const first_byte_time = Clock::now();
+    timings.time_to_first_byte = first_byte_time - request_sent_time;
 
-    std::string const response_content = std::invoke([&response_stream]() {
-      std::string content;
-      Poco::StreamCopier::copyToString(response_stream, content);
-      return content;
-    });
+    if constexpr (detail::is_tls_session<SessionType>::value)
+    {
+      if (!timings.connection_reused)
+      {
+        auto const resumed = Poco::Net::SecureStreamSocket{session.socket()}.sessionWasReused();
+        tls_session_cache().handshake_completed(uri.getHost(), uri.getPort(), session.sslSession(), resumed);
+      }
+    }
+
+    detail::CountingStreamBuffer counting_buffer{response_stream->rdbuf()};
+    std::istream counting_stream{&counting_buffer};
+    auto response_content = read_body(static_cast<HTTPResponseType const&>(response), counting_stream);
+    auto const end_time = Clock::now();
+    timings.body_transfer = end_time - first_byte_time;
+    timings.total = end_time - start_time;
+    timings.bytes_received = counting_buffer.count();
 
-    return HTTPResponse{response, response_content};
+    if (response.getKeepAlive())
+    {
+      session_lease->keep_alive();
+    }
+
+    report_http_timings(url, timings);
+    return HTTPResponse{response, std::move(response_content), timings};
+  }
+  catch (OperationCancelledException const&)
+  {
+    // The session is not kept alive, i.e. the connection of a cancelled request is closed instead of draining the body
+    throw;
+  }
+  catch (detail::BodyHandlerError const& error)
+  {
+    // Neither a HTTP nor a network error, e.g. the body could not be parsed
+    std::rethrow_exception(error.exception);
   }
   catch (std::exception const& ex)
   {
@@ -0,0 +1,270 @@
+#pragma once
+
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <iterator>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace coronan {
+
+/**
+ * Configuration of a HTTPSessionPool
+ */
+struct HTTPSessionPoolConfig
+{
+  std::chrono::milliseconds idle_timeout{std::chrono::seconds{8}}; /**< idle sessions older than this are dropped */
+  std::size_t max_sessions_per_host{8}; /**< maximum number of (idle and checked out) sessions per host */
+};
+
+/**
+ * A thread safe pool of reusable (keep-alive) HTTP sessions keyed by host and port.
+ *
+ * A session is checked out as a Lease. If the lease is marked reusable (i.e. the connection may be kept alive) the
+ * session is returned to the pool when the lease is destroyed, otherwise it is discarded.
+ */
+template <typename SessionType, typename Clock = std::chrono::steady_clock>
+class HTTPSessionPool
+{
+  struct IdleSession
+  {
+    std::unique_ptr<SessionType> session{};
+    typename Clock::time_point idle_since{};
+  };
+
+  struct HostEntry
+  {
+    std::vector<IdleSession> idle_sessions{};
+    std::size_t session_count{};
+  };
+
+public:
+  /**
+   * A checked out session. Returns the session to the pool on destruction if it was marked reusable.
+   */
+  class Lease
+  {
+  public:
+    Lease(Lease&& other) noexcept
+        : pool{std::exchange(other.pool, nullptr)}, host_key{std::move(other.host_key)},
+          session_{std::move(other.session_)}, reused_{other.reused_}, reusable{other.reusable}
+    {
+    }
+    Lease(Lease const&) = delete;
+    Lease& operator=(Lease&&) = delete;
+    Lease& operator=(Lease const&) = delete;
+
+    ~Lease()
+    {
+      if (pool != nullptr)
+      {
+        pool->checkin(host_key, std::move(session_), reusable);
+      }
+    }
+
+    /**
+     * Return the checked out session
+     */
+    SessionType& session() noexcept
+    {
+      return *session_;
+    }
+
+    /**
+     * Mark the session as reusable, i.e. the session is returned to the pool instead of discarded.
+     */
+    void keep_alive() noexcept
+    {
+      reusable = true;
+    }
+
+    /**
+     * Return true if the session is an idle session of the pool, i.e. its connection may have been closed by the
+     * server in the meantime
+     */
+    bool reused() const noexcept
+    {
+      return reused_;
+    }
+
+  private:
+    friend class HTTPSessionPool;
+    Lease(HTTPSessionPool* session_pool, std::string key, std::unique_ptr<SessionType> session, bool reused_session)
+        : pool{session_pool}, host_key{std::move(key)}, session_{std::move(session)}, reused_{reused_session}
+    {
+    }
+
+    HTTPSessionPool* pool = nullptr;
+    std::string host_key{};
+    std::unique_ptr<SessionType> session_{};
+    bool reused_ = false;
+    bool reusable = false;
+  };
+
+  /**
+   * Creates a new session for host and port
+   */
+  using SessionFactory = std::function<std::unique_ptr<SessionType>(std::string const& host, std::uint16_t port)>;
+
+  /**
+   * Constructor
+   * @param pool_config pool configuration
+   * @param session_factory creates new sessions, by default SessionType{host, port}
+   */
+  explicit HTTPSessionPool(HTTPSessionPoolConfig pool_config = {},
+                           SessionFactory session_factory = create_default_session)
+      : config{pool_config}, create_session{std::move(session_factory)}
+  {
+  }
+
+  HTTPSessionPool(HTTPSessionPool&&) = delete;
+  HTTPSessionPool(HTTPSessionPool const&) = delete;
+  HTTPSessionPool& operator=(HTTPSessionPool&&) = delete;
+  HTTPSessionPool& operator=(HTTPSessionPool const&) = delete;
+  ~HTTPSessionPool() = default;
+
+  /**
+   * Checkout a session for host:port. Reuses the most recently returned idle session if there is one, creates a new
+   * one otherwise. Blocks while max_sessions_per_host sessions for this host are checked out.
+   * @param host host name
+   * @param port port number
+   */
+  Lease checkout(std::string const& host, std::uint16_t port)
+  {
+    auto key = host + ":" + std::to_string(port);
+    std::unique_lock<std::mutex> lock{mutex};
+    auto& entry = hosts[key];
+    drop_expired(entry, Clock::now());
+    session_released.wait(lock, [&entry, this]() {
+      return !entry.idle_sessions.empty() || entry.session_count < config.max_sessions_per_host;
+    });
+
+    if (!entry.idle_sessions.empty())
+    {
+      auto session = std::move(entry.idle_sessions.back().session);
+      entry.idle_sessions.pop_back();
+      return Lease{this, std::move(key), std::move(session), true};
+    }
+
+    ++entry.session_count;
+    lock.unlock();
+    return create_lease(std::move(key), host, port);
+  }
+
+  /**
+   * Checkout a new session for host:port, e.g. to retry a request which failed on a reused session whose connection
+   * was closed by the server. If max_sessions_per_host sessions for this host exist, the least recently returned idle
+   * session is discarded for it. Blocks while max_sessions_per_host sessions for this host are checked out.
+   * @param host host name
+   * @param port port number
+   */
+  Lease checkout_new(std::string const& host, std::uint16_t port)
+  {
+    auto key = host + ":" + std::to_string(port);
+    std::unique_lock<std::mutex> lock{mutex};
+    auto& entry = hosts[key];
+    drop_expired(entry, Clock::now());
+    session_released.wait(lock, [&entry, this]() {
+      return !entry.idle_sessions.empty() || entry.session_count < config.max_sessions_per_host;
+    });
+
+    if (entry.session_count >= config.max_sessions_per_host)
+    {
+      entry.idle_sessions.erase(begin(entry.idle_sessions));
+      --entry.session_count;
+    }
+    ++entry.session_count;
+    lock.unlock();
+    return create_lease(std::move(key), host, port);
+  }
+
+  /**
+   * Return the number of idle sessions for host:port
+   */
+  std::size_t idle_sessions(std::string const& host, std::uint16_t port) const
+  {
+    std::lock_guard<std::mutex> const lock{mutex};
+    auto const entry_it = hosts.find(host + ":" + std::to_string(port));
+    return entry_it == hosts.cend() ? 0 : entry_it->second.idle_sessions.size();
+  }
+
+  /**
+   * Discard all idle sessions
+   */
+  void clear()
+  {
+    std::lock_guard<std::mutex> const lock{mutex};
+    for (auto& [key, entry] : hosts)
+    {
+      entry.session_count -= entry.idle_sessions.size();
+      entry.idle_sessions.clear();
+    }
+    session_released.notify_all();
+  }
+
+private:
+  static std::unique_ptr<SessionType> create_default_session(std::string const& host, std::uint16_t port)
+  {
+    return std::make_unique<SessionType>(host, port);
+  }
+
+  // Create a session for a slot of the host which is already counted
+  Lease create_lease(std::string key, std::string const& host, std::uint16_t port)
+  {
+    auto session = std::unique_ptr<SessionType>{};
+    try
+    {
+      session = create_session(host, port);
+    }
+    catch (...)
+    {
+      release_slot(key);
+      throw;
+    }
+    return Lease{this, std::move(key), std::move(session), false};
+  }
+
+  void checkin(std::string const& key, std::unique_ptr<SessionType> session, bool reusable)
+  {
+    if (!reusable)
+    {
+      session.reset();
+      release_slot(key);
+      return;
+    }
+    std::lock_guard<std::mutex> const lock{mutex};
+    hosts[key].idle_sessions.push_back(IdleSession{std::move(session), Clock::now()});
+    session_released.notify_one();
+  }
+
+  void release_slot(std::string const& key)
+  {
+    std::lock_guard<std::mutex> const lock{mutex};
+    --hosts[key].session_count;
+    session_released.notify_one();
+  }
+
+  void drop_expired(HostEntry& entry, typename Clock::time_point now)
+  {
+    auto const first_alive =
+        std::find_if(begin(entry.idle_sessions), end(entry.idle_sessions),
+                     [&](auto const& idle_session) { return now - idle_session.idle_since < config.idle_timeout; });
+    entry.session_count -= static_cast<std::size_t>(std::distance(begin(entry.idle_sessions), first_alive));
+    entry.idle_sessions.erase(begin(entry.idle_sessions), first_alive);
+  }
+
+  HTTPSessionPoolConfig const config;
+  SessionFactory const create_session;
+  mutable std::mutex mutex{};
+  std::condition_variable session_released{};
+  std::map<std::string, HostEntry> hosts{};
+};
+
+} // namespace coronan
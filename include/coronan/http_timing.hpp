@@ -0,0 +1,148 @@
+#pragma once
+
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <string>
+
+namespace coronan {
+
+/**
+ * Timing breakdown of a HTTP request, measured with a monotonic clock (std::chrono::steady_clock).
+ *
+ * Poco establishes a new connection (DNS lookup, TCP connect and TLS handshake) while sending the first request, so
+ * these phases are part of send_request and cannot be told apart; on a reused connection send_request only writes the
+ * request.
+ */
+struct HTTPTimings
+{
+  std::chrono::nanoseconds checkout{};           /**< waiting for a session of the session pool */
+  std::chrono::nanoseconds send_request{};       /**< connecting (if not reused) and sending the request */
+  std::chrono::nanoseconds time_to_first_byte{}; /**< waiting for the response header after the request was sent */
+  std::chrono::nanoseconds body_transfer{};      /**< receiving (and for streamed gets handling) the response body */
+  std::chrono::nanoseconds total{};              /**< the whole request */
+  std::size_t bytes_received{};                  /**< size of the received response body */
+  bool connection_reused{};                      /**< true if the request was sent on an open keep-alive connection */
+};
+
+/**
+ * Phases of HTTPTimings
+ */
+enum class HTTPPhase
+{
+  checkout,
+  send_request,
+  time_to_first_byte,
+  body_transfer,
+  total
+};
+
+/**
+ * Return the duration of phase
+ */
+std::chrono::nanoseconds phase_duration(HTTPTimings const& timings, HTTPPhase phase) noexcept;
+
+/**
+ * Receives the timings of every completed request of the HTTP clients
+ */
+using HTTPTimingSink = std::function<void(std::string const& url, HTTPTimings const& timings)>;
+
+/**
+ * Set the process wide timing sink (pass an empty sink to remove it). The sink is called concurrently by all threads
+ * doing requests, i.e. it must be thread safe.
+ */
+void set_http_timing_sink(HTTPTimingSink sink);
+
+/**
+ * Pass the timings of a completed request to the timing sink, if one is set
+ */
+void report_http_timings(std::string const& url, HTTPTimings const& timings);
+
+/**
+ * A latency histogram with logarithmic buckets (relative error of a percentile below 3.2%), e.g. to aggregate
+ * p50/p99 latencies over many requests. Not thread safe.
+ */
+class LatencyHistogram
+{
+public:
+  /**
+   * Add a latency
+   */
+  void record(std::chrono::nanoseconds latency) noexcept;
+
+  /**
+   * Return the latency below or at which the given fraction of the recorded latencies are (0 if nothing was recorded)
+   * @param quantile fraction [0, 1], e.g. 0.99 for the p99 latency
+   */
+  std::chrono::nanoseconds percentile(double quantile) const noexcept;
+
+  /**
+   * Return the number of recorded latencies
+   */
+  std::size_t count() const noexcept;
+
+private:
+  static constexpr std::size_t sub_bucket_bits = 5;
+  static constexpr std::size_t sub_bucket_count = std::size_t{1} << sub_bucket_bits;
+  static constexpr std::size_t bucket_count = (64 - sub_bucket_bits + 1) * sub_bucket_count;
+
+  static std::size_t bucket_index(uint64_t value) noexcept;
+  static uint64_t bucket_upper_bound(std::size_t index) noexcept;
+
+  std::array<uint64_t, bucket_count> buckets{};
+  std::size_t count_{};
+};
+
+/**
+ * Thread safe latency histograms of all phases of HTTP requests. Use it as timing sink to aggregate the latencies of
+ * all requests:
+ *
+ *   auto histograms = std::make_shared<HTTPTimingHistograms>();
+ *   set_http_timing_sink([histograms](auto const&, auto const& timings) { histograms->record(timings); });
+ */
+class HTTPTimingHistograms
+{
+public:
+  /**
+   * Add the timings of a request
+   */
+  void record(HTTPTimings const& timings);
+
+  /**
+   * Return the percentile of a phase (see LatencyHistogram::percentile)
+   */
+  std::chrono::nanoseconds percentile(HTTPPhase phase, double quantile) const;
+
+  /**
+   * Return the number of recorded requests
+   */
+  std::size_t count() const;
+
+  /**
+   * Return the number of recorded requests which reused a connection
+   */
+  std::size_t reused_connections() const;
+
+  /**
+   * Return the total number of received body bytes
+   */
+  uint64_t bytes_received() const;
+
+  /**
+   * Remove all recorded timings
+   */
+  void clear();
+
+private:
+  static constexpr std::size_t phase_count = 5;
+
+  mutable std::mutex mutex{};
+  std::array<LatencyHistogram, phase_count> histograms{};
+  std::size_t reused_connections_{};
+  uint64_t bytes_received_{};
+};
+
+} // namespace coronan
@@ -0,0 +1,176 @@
+#pragma once
+
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <string_view>
+
+namespace coronan::iso_date {
+
+/**
+ * A calendar date of the proleptic Gregorian calendar
+ */
+struct CivilDate
+{
+  int32_t year{};   /**< year */
+  uint32_t month{}; /**< month [1, 12] */
+  uint32_t day{};   /**< day of month [1, 31] */
+};
+
+/**
+ * Return the number of days since 1970-01-01 of a calendar date
+ */
+constexpr int32_t days_from_civil(CivilDate date) noexcept
+{
+  // http://howardhinnant.github.io/date_algorithms.html#days_from_civil
+  auto const month = static_cast<int32_t>(date.month);
+  auto const year = date.year - (month <= 2 ? 1 : 0);
+  auto const era = (year >= 0 ? year : year - 399) / 400;
+  auto const year_of_era = year - era * 400;
+  auto const day_of_year = (153 * (month > 2 ? month - 3 : month + 9) + 2) / 5 + static_cast<int32_t>(date.day) - 1;
+  auto const day_of_era = year_of_era * 365 + year_of_era / 4 - year_of_era / 100 + day_of_year;
+  return era * 146097 + day_of_era - 719468;
+}
+
+/**
+ * Return the calendar date of a number of days since 1970-01-01
+ */
+constexpr CivilDate civil_from_days(int32_t days) noexcept
+{
+  // http://howardhinnant.github.io/date_algorithms.html#civil_from_days
+  auto const shifted_days = days + 719468;
+  auto const era = (shifted_days >= 0 ? shifted_days : shifted_days - 146096) / 146097;
+  auto const day_of_era = shifted_days - era * 146097;
+  auto const year_of_era = (day_of_era - day_of_era / 1460 + day_of_era / 36524 - day_of_era / 146096) / 365;
+  auto const day_of_year = day_of_era - (365 * year_of_era + year_of_era / 4 - year_of_era / 100);
+  auto const shifted_month = (5 * day_of_year + 2) / 153;
+  auto const day = day_of_year - (153 * shifted_month + 2) / 5 + 1;
+  auto const month = shifted_month < 10 ? shifted_month + 3 : shifted_month - 9;
+  return CivilDate{year_of_era + era * 400 + (month <= 2 ? 1 : 0), static_cast<uint32_t>(month),
+                   static_cast<uint32_t>(day)};
+}
+
+namespace detail {
+constexpr std::optional<uint32_t> parse_digits(std::string_view text) noexcept
+{
+  uint32_t value = 0;
+  for (auto const character : text)
+  {
+    if (character < '0' || character > '9')
+    {
+      return std::nullopt;
+    }
+    value = value * 10 + static_cast<uint32_t>(character - '0');
+  }
+  return value;
+}
+
+constexpr uint32_t days_in_month(int32_t year, uint32_t month) noexcept
+{
+  constexpr uint32_t month_days[] = {31, 28, 31, 30, 31, 30, 31, 31, 30, 31, 30, 31};
+  auto const is_leap_year = (year % 4 == 0 && year % 100 != 0) || year % 400 == 0;
+  return month == 2 && is_leap_year ? 29 : month_days[month - 1];
+}
+} // namespace detail
+
+/**
+ * Parse the date of an ISO 8601 date or date time string (e.g. 2021-04-09 or 2021-04-09T04:20:48.000Z).
+ * @return days since 1970-01-01 or std::nullopt if iso_date does not start with a valid YYYY-MM-DD date
+ */
+constexpr std::optional<int32_t> parse_days(std::string_view iso_date) noexcept
+{
+  if (iso_date.size() < 10 || iso_date[4] != '-' || iso_date[7] != '-')
+  {
+    return std::nullopt;
+  }
+  auto const year = detail::parse_digits(iso_date.substr(0, 4));
+  auto const month = detail::parse_digits(iso_date.substr(5, 2));
+  auto const day = detail::parse_digits(iso_date.substr(8, 2));
+  if (!year || !month || !day || *month < 1 || *month > 12 || *day < 1 ||
+      *day > detail::days_in_month(static_cast<int32_t>(*year), *month))
+  {
+    return std::nullopt;
+  }
+  return days_from_civil(CivilDate{static_cast<int32_t>(*year), *month, *day});
+}
+
+/**
+ * Parse an ISO 8601 UTC date time string of the form YYYY-MM-DDThh:mm:ss[.f...]Z (e.g. 2021-04-09T04:20:48.000Z).
+ * Fractional seconds are truncated.
+ * @return seconds since 1970-01-01T00:00:00Z or std::nullopt if iso_date_time is not of that form
+ */
+constexpr std::optional<int64_t> parse_seconds(std::string_view iso_date_time) noexcept
+{
+  if (iso_date_time.size() < 20 || iso_date_time[10] != 'T' || iso_date_time[13] != ':' || iso_date_time[16] != ':' ||
+      iso_date_time.back() != 'Z')
+  {
+    return std::nullopt;
+  }
+  auto const fraction = iso_date_time.substr(19, iso_date_time.size() - 20);
+  if (!fraction.empty() && (fraction.size() < 2 || fraction[0] != '.' || !detail::parse_digits(fraction.substr(1))))
+  {
+    return std::nullopt;
+  }
+  auto const days = parse_days(iso_date_time);
+  auto const hours = detail::parse_digits(iso_date_time.substr(11, 2));
+  auto const minutes = detail::parse_digits(iso_date_time.substr(14, 2));
+  auto const seconds = detail::parse_digits(iso_date_time.substr(17, 2));
+  if (!days || !hours || !minutes || !seconds || *hours > 23 || *minutes > 59 || *seconds > 60)
+  {
+    return std::nullopt;
+  }
+  return int64_t{*days} * 86400 + int64_t{*hours} * 3600 + int64_t{*minutes} * 60 + int64_t{*seconds};
+}
+
+/**
+ * Format a number of days since 1970-01-01 as ISO 8601 date (YYYY-MM-DD)
+ */
+inline std::string format_days(int32_t days)
+{
+  auto const date = civil_from_days(days);
+  auto const two_digits = [](uint32_t value) {
+    return std::string{static_cast<char>('0' + value / 10), static_cast<char>('0' + value % 10)};
+  };
+  auto year = std::to_string(date.year);
+  if (date.year >= 0 && year.size() < 4)
+  {
+    year.insert(0, 4 - year.size(), '0');
+  }
+  return year + "-" + two_digits(date.month) + "-" + two_digits(date.day);
+}
+
+/**
+ * A calendar date and time of day (UTC)
+ */
+struct CivilDateTime
+{
+  CivilDate date{};  /**< calendar date */
+  uint32_t hour{};   /**< hour [0, 23] */
+  uint32_t minute{}; /**< minute [0, 59] */
+  uint32_t second{}; /**< second [0, 59] */
+};
+
+/**
+ * Return the calendar date and time of day of a number of seconds since 1970-01-01T00:00:00Z
+ */
+constexpr CivilDateTime civil_from_seconds(int64_t seconds) noexcept
+{
+  auto const days = static_cast<int32_t>((seconds >= 0 ? seconds : seconds - 86399) / 86400);
+  auto const time_of_day = static_cast<uint32_t>(seconds - int64_t{days} * 86400);
+  return CivilDateTime{civil_from_days(days), time_of_day / 3600, time_of_day / 60 % 60, time_of_day % 60};
+}
+
+/**
+ * Format a number of seconds since 1970-01-01T00:00:00Z as ISO 8601 UTC date time (YYYY-MM-DDThh:mm:ssZ)
+ */
+inline std::string format_seconds(int64_t seconds)
+{
+  auto const date_time = civil_from_seconds(seconds);
+  auto const two_digits = [](uint32_t value) {
+    return std::string{static_cast<char>('0' + value / 10), static_cast<char>('0' + value % 10)};
+  };
+  return format_days(days_from_civil(date_time.date)) + "T" + two_digits(date_time.hour) + ":" +
+         two_digits(date_time.minute) + ":" + two_digits(date_time.second) + "Z";
+}
+
+} // namespace coronan::iso_date
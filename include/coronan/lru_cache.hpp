@@ -0,0 +1,140 @@
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <list>
+#include <mutex>
+#include <optional>
+#include <unordered_map>
+#include <utility>
+
+namespace coronan {
+
+/**
+ * Cache usage counters
+ */
+struct CacheStatistics
+{
+  std::size_t hits{};          /**< number of lookups answered from the cache */
+  std::size_t misses{};        /**< number of lookups not found in the cache (including expired entries) */
+  std::size_t evictions{};     /**< number of entries removed to respect the capacity */
+  std::size_t expirations{};   /**< number of entries removed because their time to live was exceeded */
+  std::size_t revalidations{}; /**< number of expired entries confirmed unchanged by the server */
+};
+
+/**
+ * A thread safe, size bounded least recently used (LRU) cache with a time to live (TTL) per entry.
+ */
+template <typename Key, typename Value, typename Clock = std::chrono::steady_clock>
+class LRUCache
+{
+public:
+  /**
+   * Constructor
+   * @param max_entries maximum number of entries. The least recently used entry is evicted if exceeded.
+   * @param time_to_live time an entry is valid after it was put into the cache
+   */
+  LRUCache(std::size_t max_entries, typename Clock::duration time_to_live)
+      : capacity{max_entries}, ttl{time_to_live}
+  {
+  }
+
+  /**
+   * Return a copy of the cached value of key, or std::nullopt if there is no valid entry for key
+   */
+  std::optional<Value> get(Key const& key)
+  {
+    std::lock_guard<std::mutex> const lock{mutex};
+    auto const entry_it = index.find(key);
+    if (entry_it == index.end())
+    {
+      ++statistics_.misses;
+      return std::nullopt;
+    }
+    auto const list_it = entry_it->second;
+    if (Clock::now() >= list_it->expires_at)
+    {
+      entries.erase(list_it);
+      index.erase(entry_it);
+      ++statistics_.expirations;
+      ++statistics_.misses;
+      return std::nullopt;
+    }
+    entries.splice(entries.begin(), entries, list_it);
+    ++statistics_.hits;
+    return list_it->value;
+  }
+
+  /**
+   * Insert or replace the value of key
+   */
+  void put(Key const& key, Value value)
+  {
+    std::lock_guard<std::mutex> const lock{mutex};
+    auto const expires_at = Clock::now() + ttl;
+    if (auto const entry_it = index.find(key); entry_it != index.end())
+    {
+      entry_it->second->value = std::move(value);
+      entry_it->second->expires_at = expires_at;
+      entries.splice(entries.begin(), entries, entry_it->second);
+      return;
+    }
+    if (capacity == 0)
+    {
+      return;
+    }
+    if (entries.size() >= capacity)
+    {
+      index.erase(entries.back().key);
+      entries.pop_back();
+      ++statistics_.evictions;
+    }
+    entries.push_front(Entry{key, std::move(value), expires_at});
+    index.emplace(key, entries.begin());
+  }
+
+  /**
+   * Remove all entries
+   */
+  void clear()
+  {
+    std::lock_guard<std::mutex> const lock{mutex};
+    entries.clear();
+    index.clear();
+  }
+
+  /**
+   * Return the number of entries (including expired ones not yet removed)
+   */
+  std::size_t size() const
+  {
+    std::lock_guard<std::mutex> const lock{mutex};
+    return entries.size();
+  }
+
+  /**
+   * Return the usage counters
+   */
+  CacheStatistics statistics() const
+  {
+    std::lock_guard<std::mutex> const lock{mutex};
+    return statistics_;
+  }
+
+private:
+  struct Entry
+  {
+    Key key;
+    Value value;
+    typename Clock::time_point expires_at;
+  };
+
+  std::size_t const capacity;
+  typename Clock::duration const ttl;
+  mutable std::mutex mutex{};
+  std::list<Entry> entries{}; // most recently used first
+  std::unordered_map<Key, typename std::list<Entry>::iterator> index{};
+  CacheStatistics statistics_{};
+};
+
+} // namespace coronan
@@ -23,6 +23,15 @@ public:
    */
   [[nodiscard]] static std::unique_ptr<SSLClient> create_with_accept_certificate_handler();
 
+  /**
+   * Return the process wide SSLClient with an accept all certificates handler, shared by all clients and threads.
+   * It is created on the first call and lives until the process exits, i.e. it is never destroyed and the SSL runtime
+   * is not uninitialized. The kept alive HTTPS sessions and cached TLS sessions (see HTTPClientType) therefore stay
+   * valid when all clients are gone. Thread safe.
+   * @return process wide SSLClient
+   */
+  static SSLClient& shared_with_accept_certificate_handler();
+
   ~SSLClient();
 
   SSLClient(SSLClient&&) = delete;
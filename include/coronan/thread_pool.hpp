@@ -0,0 +1,82 @@
+#pragma once
+
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+namespace coronan {
+
+/**
+ * A fixed size pool of worker threads executing submitted tasks in FIFO order.
+ * At most thread_count tasks run concurrently. The destructor waits until all submitted tasks are done.
+ */
+class ThreadPool
+{
+public:
+  /**
+   * Constructor
+   * @param thread_count number of worker threads (at least one thread is started)
+   */
+  explicit ThreadPool(std::size_t thread_count);
+  ~ThreadPool();
+
+  ThreadPool(ThreadPool&&) = delete;
+  ThreadPool(ThreadPool const&) = delete;
+  ThreadPool& operator=(ThreadPool&&) = delete;
+  ThreadPool& operator=(ThreadPool const&) = delete;
+
+  /**
+   * Submit a task for execution
+   * @param task callable without arguments
+   * @return future of the task result. Exceptions thrown by the task are passed through the future.
+   */
+  template <typename Func>
+  std::future<std::invoke_result_t<std::decay_t<Func>>> submit(Func&& task);
+
+  /**
+   * Return the number of worker threads
+   */
+  std::size_t size() const noexcept;
+
+  /**
+   * Return the process wide pool executing asynchronous requests (see CoronaAPIClientType::request_country_data_async).
+   * The pool has shared_thread_count threads and lives until the process exits.
+   */
+  static ThreadPool& shared();
+
+  /**
+   * Number of worker threads of the shared pool. Matches the default number of sessions per host of the
+   * HTTPSessionPool.
+   */
+  static constexpr std::size_t shared_thread_count = 8;
+
+private:
+  void enqueue(std::function<void()> task);
+  void run();
+
+  std::mutex mutex{};
+  std::condition_variable task_available{};
+  std::deque<std::function<void()>> tasks{};
+  bool stopping = false;
+  std::vector<std::thread> workers{};
+};
+
+template <typename Func>
+std::future<std::invoke_result_t<std::decay_t<Func>>> ThreadPool::submit(Func&& task)
+{
+  using ResultType = std::invoke_result_t<std::decay_t<Func>>;
+  // std::function requires a copyable callable, the packaged_task is therefore shared
+  auto packaged_task = std::make_shared<std::packaged_task<ResultType()>>(std::forward<Func>(task));
+  auto result = packaged_task->get_future();
+  enqueue([packaged_task]() { (*packaged_task)(); });
+  return result;
+}
+
+} // namespace coronan
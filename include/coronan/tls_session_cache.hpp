@@ -0,0 +1,60 @@
+#pragma once
+
+#include <Poco/Net/Session.h>
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <mutex>
+#include <string>
+
+namespace coronan {
+
+/**
+ * TLS handshake counters
+ */
+struct TLSHandshakeStatistics
+{
+  std::size_t full_handshakes{};    /**< number of handshakes which negotiated a new TLS session */
+  std::size_t resumed_handshakes{}; /**< number of abbreviated handshakes which resumed a cached TLS session */
+};
+
+/**
+ * A thread safe cache of the latest TLS session per host and port. A new HTTPS session created with the cached TLS
+ * session resumes it (abbreviated handshake) instead of negotiating a new one, provided that the session cache of the
+ * SSL context is enabled.
+ */
+class TLSSessionCache
+{
+public:
+  /**
+   * Return the cached TLS session of host:port (null if there is none)
+   */
+  Poco::Net::Session::Ptr get(std::string const& host, std::uint16_t port) const;
+
+  /**
+   * Record a completed handshake with host:port and cache its TLS session
+   * @param host host name
+   * @param port port number
+   * @param session TLS session of the connection
+   * @param resumed true if the handshake resumed a cached TLS session
+   */
+  void handshake_completed(std::string const& host, std::uint16_t port, Poco::Net::Session::Ptr session,
+                           bool resumed);
+
+  /**
+   * Return the handshake counters
+   */
+  TLSHandshakeStatistics statistics() const;
+
+  /**
+   * Discard all cached TLS sessions
+   */
+  void clear();
+
+private:
+  mutable std::mutex mutex{};
+  std::map<std::string, Poco::Net::Session::Ptr> sessions{};
+  TLSHandshakeStatistics statistics_{};
+};
+
+} // namespace coronan
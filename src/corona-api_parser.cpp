@@ -1,16 +1,31 @@
 #include "coronan/corona-api_parser.hpp"
 
+#include "corona-api_sax_parser.hpp"
+#include "corona-api_simdjson_parser.hpp"
+#include "coronan/iso_date.hpp"
+#include "document_arena_state.hpp"
+
 #include <algorithm>
+#include <array>
+#include <istream>
+#include <limits>
+#include <memory>
 #include <rapidjson/document.h>
+#include <rapidjson/error/en.h>
+#include <rapidjson/istreamwrapper.h>
+#include <stdexcept>
+#include <string_view>
+#include <type_traits>
+#include <variant>
 
 namespace coronan::api_parser {
 
 namespace {
 
 template <typename Ret_T, typename DOM_T, std::enable_if_t<std::is_arithmetic<Ret_T>::value, bool> = true>
-std::optional<Ret_T> get_value(DOM_T const& json_dom_object, std::string const& name)
+std::optional<Ret_T> get_value(DOM_T const& json_dom_object, char const* name)
 {
-  if (auto member_it = json_dom_object.FindMember(name.c_str()); member_it != json_dom_object.MemberEnd())
+  if (auto member_it = json_dom_object.FindMember(name); member_it != json_dom_object.MemberEnd())
   {
     if (auto const& value = member_it->value; value.IsNumber())
     {
@@ -45,9 +60,9 @@ std::optional<Ret_T> get_value(DOM_T const& json_dom_object, std::string const&
 }
 
 template <typename Ret_T, typename DOM_T, std::enable_if_t<std::is_same<Ret_T, std::string>::value, bool> = true>
-Ret_T get_value(DOM_T const& json_dom_object, std::string const& name)
+Ret_T get_value(DOM_T const& json_dom_object, char const* name)
 {
-  if (auto member_it = json_dom_object.FindMember(name.c_str()); member_it != json_dom_object.MemberEnd())
+  if (auto member_it = json_dom_object.FindMember(name); member_it != json_dom_object.MemberEnd())
   {
     auto const& value = member_it->value;
     if (value.IsString())
@@ -62,97 +77,589 @@ Ret_T get_value(DOM_T const& json_dom_object, std::string const& name)
   return "";
 }
 
-constexpr auto parse_today_data = [](auto const& json_dom_object) {
-  CountryData::TodayData today{};
+// The string value of a json value without copying it, empty if the value is not a string
+template <typename DOM_T>
+std::string_view get_string_view(DOM_T const& value)
+{
+  return value.IsString() ? std::string_view{value.GetString(), value.GetStringLength()} : std::string_view{};
+}
+
+// The string value of a member without copying it, empty if the member is not a string
+template <typename Ret_T, typename DOM_T, std::enable_if_t<std::is_same<Ret_T, std::string_view>::value, bool> = true>
+Ret_T get_value(DOM_T const& json_dom_object, char const* name)
+{
+  if (auto member_it = json_dom_object.FindMember(name); member_it != json_dom_object.MemberEnd())
+  {
+    return get_string_view(member_it->value);
+  }
+  return {};
+}
+
+/**
+ * FNV-1a hash of a member key, seeded to find a collision free (perfect) hash of the keys of a FieldTable
+ */
+constexpr uint32_t hash_key(std::string_view key, uint32_t seed) noexcept
+{
+  auto hash = 2166136261U ^ seed;
+  for (auto const character : key)
+  {
+    hash = (hash ^ static_cast<unsigned char>(character)) * 16777619U;
+  }
+  return hash;
+}
+
+constexpr std::size_t next_power_of_two(std::size_t value) noexcept
+{
+  std::size_t power = 1;
+  while (power < value)
+  {
+    power *= 2;
+  }
+  return power;
+}
+
+/**
+ * Compile time perfect hash table of the member keys of a json object. Field is a descriptor of a member with (at
+ * least) a std::string_view key. The hash seed is searched at compile time, i.e. looking up a key costs hashing the
+ * key and a single key comparison without any temporary string.
+ */
+template <typename Field, std::size_t FieldCount>
+class FieldTable
+{
+public:
+  constexpr explicit FieldTable(std::array<Field, FieldCount> const& fields_) : fields{fields_}
+  {
+    for (uint32_t seed_ = 0; seed_ < max_seed; ++seed_)
+    {
+      if (try_seed(seed_))
+      {
+        return;
+      }
+    }
+    throw std::logic_error{"No perfect hash found for the field keys"};
+  }
+
+  /**
+   * Return the descriptor of the member key, nullptr if key is not a field
+   */
+  constexpr Field const* find(std::string_view key) const noexcept
+  {
+    auto const field_index = slots[hash_key(key, seed) & slot_mask];
+    return field_index != empty_slot && fields[field_index].key == key ? &fields[field_index] : nullptr;
+  }
+
+private:
+  // A sparse table (load factor <= 1/4) to find a perfect hash seed quickly
+  static constexpr std::size_t slot_count = next_power_of_two(4 * FieldCount);
+  static constexpr std::size_t slot_mask = slot_count - 1;
+  static constexpr uint8_t empty_slot = std::numeric_limits<uint8_t>::max();
+  static constexpr uint32_t max_seed = 1024;
+  static_assert(FieldCount < empty_slot, "Too many fields");
+
+  constexpr bool try_seed(uint32_t seed_)
+  {
+    for (auto& slot : slots)
+    {
+      slot = empty_slot;
+    }
+    for (std::size_t field_index = 0; field_index < FieldCount; ++field_index)
+    {
+      auto& slot = slots[hash_key(fields[field_index].key, seed_) & slot_mask];
+      if (slot != empty_slot)
+      {
+        return false;
+      }
+      slot = static_cast<uint8_t>(field_index);
+    }
+    seed = seed_;
+    return true;
+  }
+
+  std::array<Field, FieldCount> fields;
+  std::array<uint8_t, slot_count> slots{};
+  uint32_t seed{};
+};
+
+/**
+ * A number member (or ISO 8601 date time string member, stored as seconds since epoch) of Object
+ */
+template <typename Object>
+using FieldMember =
+    std::variant<std::optional<uint32_t> Object::*, std::optional<double> Object::*, std::optional<int64_t> Object::*>;
+
+template <typename Object>
+struct FieldDescriptor
+{
+  std::string_view key{};       /**< json member key */
+  FieldMember<Object> member{}; /**< target of the json value */
+  FieldSet field{};             /**< field of the projection, the member is always assigned if empty */
+};
+
+// Same conversions as get_value: only unsigned values are accepted as unsigned and only floating point values as
+// double
+template <typename Object, typename DOM_T>
+void assign_field(Object& object, FieldMember<Object> const& member, DOM_T const& value)
+{
+  std::visit(
+      [&object, &value](auto const field) {
+        using Field_T = typename std::remove_reference_t<decltype(object.*field)>::value_type;
+        if constexpr (std::is_same<Field_T, uint32_t>::value)
+        {
+          object.*field = value.IsUint() ? std::optional<uint32_t>{value.GetUint()} : std::nullopt;
+        }
+        else if constexpr (std::is_same<Field_T, double>::value)
+        {
+          object.*field = value.IsDouble() ? std::optional<double>{value.GetDouble()} : std::nullopt;
+        }
+        else
+        {
+          object.*field = iso_date::parse_seconds(get_string_view(value));
+        }
+      },
+      member);
+}
+
+/**
+ * Assign the members of a json object to the selected fields of object in a single pass over the json members
+ */
+template <typename Object, std::size_t FieldCount, typename DOM_T>
+void parse_fields(DOM_T const& json_dom_object, FieldTable<FieldDescriptor<Object>, FieldCount> const& fields,
+                  Object& object, FieldSet selected = fields::all)
+{
+  for (auto member_it = json_dom_object.MemberBegin(); member_it != json_dom_object.MemberEnd(); ++member_it)
+  {
+    if (auto const* field = fields.find(get_string_view(member_it->name));
+        field != nullptr && selected.contains(field->field))
+    {
+      assign_field(object, field->member, member_it->value);
+    }
+  }
+}
+
+template <typename Data>
+constexpr auto today_fields = FieldTable{std::array{
+    FieldDescriptor<typename Data::TodayData>{"deaths", &Data::TodayData::deaths},
+    FieldDescriptor<typename Data::TodayData>{"confirmed", &Data::TodayData::confirmed},
+}};
+
+template <typename Data>
+constexpr auto latest_fields = FieldTable{std::array{
+    FieldDescriptor<typename Data::LatestData>{"deaths", &Data::LatestData::deaths},
+    FieldDescriptor<typename Data::LatestData>{"confirmed", &Data::LatestData::confirmed},
+    FieldDescriptor<typename Data::LatestData>{"recovered", &Data::LatestData::recovered},
+    FieldDescriptor<typename Data::LatestData>{"critical", &Data::LatestData::critical},
+}};
+
+template <typename Data>
+constexpr auto calculated_fields = FieldTable{std::array{
+    FieldDescriptor<typename Data::LatestData>{"death_rate", &Data::LatestData::death_rate},
+    FieldDescriptor<typename Data::LatestData>{"recovery_rate", &Data::LatestData::recovery_rate},
+    FieldDescriptor<typename Data::LatestData>{"recovered_vs_death_ratio", &Data::LatestData::recovered_vs_death_ratio},
+    FieldDescriptor<typename Data::LatestData>{"cases_per_million_population",
+                                               &Data::LatestData::cases_per_million_population},
+}};
+
+template <typename Data>
+constexpr auto timeline_fields = FieldTable{std::array{
+    FieldDescriptor<typename Data::TimelineData>{"updated_at", &Data::TimelineData::date},
+    FieldDescriptor<typename Data::TimelineData>{"deaths", &Data::TimelineData::deaths, fields::timeline::deaths},
+    FieldDescriptor<typename Data::TimelineData>{"confirmed", &Data::TimelineData::confirmed,
+                                                 fields::timeline::confirmed},
+    FieldDescriptor<typename Data::TimelineData>{"recovered", &Data::TimelineData::recovered,
+                                                 fields::timeline::recovered},
+    FieldDescriptor<typename Data::TimelineData>{"active", &Data::TimelineData::active, fields::timeline::active},
+    FieldDescriptor<typename Data::TimelineData>{"new_confirmed", &Data::TimelineData::new_confirmed,
+                                                 fields::timeline::new_confirmed},
+    FieldDescriptor<typename Data::TimelineData>{"new_recovered", &Data::TimelineData::new_recovered,
+                                                 fields::timeline::new_recovered},
+    FieldDescriptor<typename Data::TimelineData>{"new_deaths", &Data::TimelineData::new_deaths,
+                                                 fields::timeline::new_deaths},
+}};
+
+void throw_on_parse_error(detail::ArenaDocument const& document)
+{
+  if (document.HasParseError())
+  {
+    throw ParseException{rapidjson::GetParseError_En(document.GetParseError()), document.GetErrorOffset()};
+  }
+}
+
+template <typename Data, typename DOM_T>
+typename Data::TodayData parse_today_data(DOM_T const& json_dom_object)
+{
+  typename Data::TodayData today{};
   if (json_dom_object.HasMember("today"))
   {
-    auto const today_object = json_dom_object["today"].GetObject();
-    today.deaths = get_value<uint32_t>(today_object, "deaths");
-    today.confirmed = get_value<uint32_t>(today_object, "confirmed");
+    parse_fields(json_dom_object["today"].GetObject(), today_fields<Data>, today);
   }
   return today;
-};
+}
 
-constexpr auto parse_latest_data = [](auto const& json_dom_object) {
-  CountryData::LatestData latest{};
+template <typename Data, typename DOM_T>
+typename Data::LatestData parse_latest_data(DOM_T const& json_dom_object)
+{
+  typename Data::LatestData latest{};
   if (json_dom_object.HasMember("latest_data"))
   {
     auto const latest_data = json_dom_object["latest_data"].GetObject();
-    latest.deaths = get_value<uint32_t>(latest_data, "deaths");
-    latest.confirmed = get_value<uint32_t>(latest_data, "confirmed");
-    latest.recovered = get_value<uint32_t>(latest_data, "recovered");
-    latest.critical = get_value<uint32_t>(latest_data, "critical");
+    parse_fields(latest_data, latest_fields<Data>, latest);
     if (latest_data.HasMember("calculated"))
     {
-      auto const calculated = latest_data["calculated"].GetObject();
-      latest.death_rate = get_value<double>(calculated, "death_rate");
-      latest.recovery_rate = get_value<double>(calculated, "recovery_rate");
-      latest.recovered_vs_death_ratio = get_value<double>(calculated, "recovered_vs_death_ratio");
-      latest.cases_per_million_population = get_value<uint32_t>(calculated, "cases_per_million_population");
+      parse_fields(latest_data["calculated"].GetObject(), calculated_fields<Data>, latest);
     }
   }
   return latest;
-};
+}
 
-constexpr auto parse_timeline = [](auto const& json_dom_object) {
-  std::vector<CountryData::TimelineData> timeline;
+template <typename Data, typename DOM_T>
+std::vector<typename Data::TimelineData> parse_timeline_data(DOM_T const& json_dom_object, FieldSet selected)
+{
+  std::vector<typename Data::TimelineData> timeline;
   if (json_dom_object.HasMember("timeline"))
   {
-    for (auto const& data_point : json_dom_object["timeline"].GetArray())
+    auto const data_points = json_dom_object["timeline"].GetArray();
+    timeline.reserve(data_points.Size());
+    for (auto const& data_point : data_points)
     {
-      CountryData::TimelineData timepoint;
-      timepoint.date = get_value<std::string>(data_point, "updated_at");
-      timepoint.deaths = get_value<uint32_t>(data_point, "deaths");
-      timepoint.confirmed = get_value<uint32_t>(data_point, "confirmed");
-      timepoint.recovered = get_value<uint32_t>(data_point, "recovered");
-      timepoint.active = get_value<uint32_t>(data_point, "active");
-      timepoint.new_confirmed = get_value<uint32_t>(data_point, "new_confirmed");
-      timepoint.new_recovered = get_value<uint32_t>(data_point, "new_recovered");
-      timepoint.new_deaths = get_value<uint32_t>(data_point, "new_deaths");
-      timeline.emplace_back(timepoint);
+      // Same as the SAX parser: values which are not objects are skipped
+      if (data_point.IsObject())
+      {
+        parse_fields(data_point, timeline_fields<Data>, timeline.emplace_back(), selected);
+      }
     }
   }
   return timeline;
-};
-
-} // namespace
+}
 
-// cppcheck-suppress unusedFunction
-CountryData parse_country(std::string const& json)
+// Data is CountryData or CountryDataView, the strings of a CountryDataView point into the (in-situ parsed) document.
+// Only the selected fields are read from the document.
+template <typename Data>
+Data parse_country_dom(detail::ArenaDocument const& document, FieldSet selected = fields::all)
 {
-  rapidjson::Document document;
-  document.Parse<rapidjson::kParseFullPrecisionFlag>(json.c_str());
-  auto country_data = CountryData{};
+  throw_on_parse_error(document);
+  using String = decltype(Data::info.name);
+  auto country_data = Data{};
   if (document.HasMember("data"))
   {
     auto const country_data_object = document["data"].GetObject();
-    country_data.info.name = get_value<std::string>(country_data_object, "name");
-    country_data.info.iso_code = get_value<std::string>(country_data_object, "code");
-    country_data.info.population = get_value<uint32_t>(country_data_object, "population");
-    country_data.today = parse_today_data(country_data_object);
-
-    auto const current_date = get_value<std::string>(country_data_object, "updated_at");
-    country_data.today.date = current_date;
-    country_data.latest = parse_latest_data(country_data_object);
-    country_data.latest.date = current_date;
-    country_data.timeline = parse_timeline(country_data_object);
+    if (selected.contains(fields::info))
+    {
+      country_data.info.name = get_value<String>(country_data_object, "name");
+      country_data.info.iso_code = get_value<String>(country_data_object, "code");
+      country_data.info.population = get_value<uint32_t>(country_data_object, "population");
+    }
+    auto const current_date = selected.intersects(fields::today | fields::latest)
+                                  ? get_value<String>(country_data_object, "updated_at")
+                                  : String{};
+    if (selected.contains(fields::today))
+    {
+      country_data.today = parse_today_data<Data>(country_data_object);
+      country_data.today.date = current_date;
+    }
+    if (selected.contains(fields::latest))
+    {
+      country_data.latest = parse_latest_data<Data>(country_data_object);
+      country_data.latest.date = current_date;
+    }
+    if (selected.intersects(fields::timeline::all))
+    {
+      country_data.timeline = parse_timeline_data<Data>(country_data_object, selected);
+    }
   }
   return country_data;
 }
-// cppcheck-suppress unusedFunction
-CountryListObject parse_countries(std::string const& json)
+
+/**
+ * A member of a timeline point, the date if metric is std::nullopt
+ */
+struct MetricField
+{
+  std::string_view key{};                  /**< json member key */
+  std::optional<Timeline::Metric> metric{}; /**< metric of the json value */
+};
+
+constexpr FieldTable metric_fields{std::array{
+    MetricField{"updated_at", std::nullopt},
+    MetricField{"deaths", Timeline::Metric::deaths},
+    MetricField{"confirmed", Timeline::Metric::confirmed},
+    MetricField{"active", Timeline::Metric::active},
+    MetricField{"recovered", Timeline::Metric::recovered},
+    MetricField{"new_deaths", Timeline::Metric::new_deaths},
+    MetricField{"new_confirmed", Timeline::Metric::new_confirmed},
+    MetricField{"new_recovered", Timeline::Metric::new_recovered},
+}};
+
+Timeline parse_timeline_dom(detail::ArenaDocument const& document)
+{
+  throw_on_parse_error(document);
+  auto timeline = Timeline{};
+  if (document.HasMember("data") && document["data"].HasMember("timeline"))
+  {
+    auto const data_points = document["data"]["timeline"].GetArray();
+    timeline.reserve(data_points.Size());
+    for (auto const& data_point : data_points)
+    {
+      if (!data_point.IsObject())
+      {
+        continue;
+      }
+      std::optional<int32_t> date{};
+      std::array<std::optional<uint32_t>, Timeline::metric_count> values{};
+      for (auto member_it = data_point.MemberBegin(); member_it != data_point.MemberEnd(); ++member_it)
+      {
+        auto const* field = metric_fields.find(get_string_view(member_it->name));
+        if (field == nullptr)
+        {
+          continue;
+        }
+        auto const& value = member_it->value;
+        if (!field->metric.has_value())
+        {
+          date = iso_date::parse_days(get_string_view(value));
+        }
+        else if (value.IsUint())
+        {
+          values[static_cast<std::size_t>(field->metric.value())] = value.GetUint();
+        }
+      }
+
+      auto const index = timeline.size();
+      timeline.push_back(date);
+      for (std::size_t metric = 0; metric < values.size(); ++metric)
+      {
+        if (values[metric].has_value())
+        {
+          timeline.set(index, static_cast<Timeline::Metric>(metric), values[metric].value());
+        }
+      }
+    }
+  }
+  return timeline;
+}
+
+// List is CountryListObject or CountryListView (see parse_country_dom)
+template <typename List>
+List parse_countries_dom(detail::ArenaDocument const& document)
 {
-  rapidjson::Document document;
-  document.Parse(json.c_str());
-  auto country_list = CountryListObject{};
+  throw_on_parse_error(document);
+  using Info = typename List::value_type;
+  using String = decltype(Info::name);
+  auto country_list = List{};
   for (auto const& country_data : document["data"].GetArray())
   {
-    CountryInfo country;
-    country.name = get_value<std::string>(country_data, "name");
-    country.iso_code = get_value<std::string>(country_data, "code");
+    Info country;
+    country.name = get_value<String>(country_data, "name");
+    country.iso_code = get_value<String>(country_data, "code");
     country_list.emplace_back(country);
   }
   return country_list;
 }
 
+// The simdjson engine falls back to the SAX engine if simdjson is not available (see simdjson_implementation)
+ParserEngine select_engine(ParserEngine engine)
+{
+  static bool const simdjson_available = !on_demand::implementation().empty();
+  return engine == ParserEngine::simdjson && !simdjson_available ? ParserEngine::sax : engine;
+}
+
+} // namespace
+
+ParseException::ParseException(std::string const& error, std::size_t offset)
+    : msg{"Invalid json at offset " + std::to_string(offset) + ": " + error}, offset_{offset}
+{
+}
+
+char const* ParseException::what() const noexcept
+{
+  return msg.c_str();
+}
+
+std::size_t ParseException::offset() const noexcept
+{
+  return offset_;
+}
+
+std::string simdjson_implementation()
+{
+  return on_demand::implementation();
+}
+
+// cppcheck-suppress unusedFunction
+CountryData parse_country(std::string const& json, ParserEngine engine)
+{
+  return parse_country(json, fields::all, engine);
+}
+
+// cppcheck-suppress unusedFunction
+CountryData parse_country(std::string const& json, FieldSet fields, ParserEngine engine)
+{
+  switch (select_engine(engine))
+  {
+  case ParserEngine::sax:
+    return sax::parse_country(json, fields);
+  case ParserEngine::simdjson:
+    return on_demand::parse_country(json, fields);
+  default:
+    return parse_country(json, DocumentArena::this_thread(), fields);
+  }
+}
+
+// cppcheck-suppress unusedFunction
+CountryListObject parse_countries(std::string const& json, ParserEngine engine)
+{
+  switch (select_engine(engine))
+  {
+  case ParserEngine::sax:
+    return sax::parse_countries(json);
+  case ParserEngine::simdjson:
+    return on_demand::parse_countries(json);
+  default:
+    return parse_countries(json, DocumentArena::this_thread());
+  }
+}
+
+// cppcheck-suppress unusedFunction
+Timeline parse_timeline(std::string const& json, ParserEngine engine)
+{
+  switch (select_engine(engine))
+  {
+  case ParserEngine::sax:
+    return sax::parse_timeline(json);
+  case ParserEngine::simdjson:
+    return on_demand::parse_timeline(json);
+  default:
+    return api_parser::parse_timeline(json, DocumentArena::this_thread());
+  }
+}
+
+// cppcheck-suppress unusedFunction
+CountryData parse_country(std::istream& json_stream, ParserEngine engine)
+{
+  return parse_country(json_stream, fields::all, engine);
+}
+
+// cppcheck-suppress unusedFunction
+CountryData parse_country(std::istream& json_stream, FieldSet fields, ParserEngine engine)
+{
+  switch (select_engine(engine))
+  {
+  case ParserEngine::sax:
+    return sax::parse_country(json_stream, fields);
+  case ParserEngine::simdjson:
+    return on_demand::parse_country(json_stream, fields);
+  default:
+    return parse_country(json_stream, DocumentArena::this_thread(), fields);
+  }
+}
+
+// cppcheck-suppress unusedFunction
+CountryListObject parse_countries(std::istream& json_stream, ParserEngine engine)
+{
+  switch (select_engine(engine))
+  {
+  case ParserEngine::sax:
+    return sax::parse_countries(json_stream);
+  case ParserEngine::simdjson:
+    return on_demand::parse_countries(json_stream);
+  default:
+    return parse_countries(json_stream, DocumentArena::this_thread());
+  }
+}
+
+// cppcheck-suppress unusedFunction
+Timeline parse_timeline(std::istream& json_stream, ParserEngine engine)
+{
+  switch (select_engine(engine))
+  {
+  case ParserEngine::sax:
+    return sax::parse_timeline(json_stream);
+  case ParserEngine::simdjson:
+    return on_demand::parse_timeline(json_stream);
+  default:
+    return api_parser::parse_timeline(json_stream, DocumentArena::this_thread());
+  }
+}
+
+CountryData parse_country(std::string const& json, DocumentArena& arena, FieldSet fields)
+{
+  return detail::arena_state(arena).parse([&json, fields](detail::ArenaDocument& document) {
+    document.Parse<rapidjson::kParseFullPrecisionFlag>(json.c_str());
+    return parse_country_dom<CountryData>(document, fields);
+  });
+}
+
+CountryListObject parse_countries(std::string const& json, DocumentArena& arena)
+{
+  return detail::arena_state(arena).parse([&json](detail::ArenaDocument& document) {
+    document.Parse(json.c_str());
+    return parse_countries_dom<CountryListObject>(document);
+  });
+}
+
+Timeline parse_timeline(std::string const& json, DocumentArena& arena)
+{
+  return detail::arena_state(arena).parse([&json](detail::ArenaDocument& document) {
+    document.Parse(json.c_str());
+    return parse_timeline_dom(document);
+  });
+}
+
+CountryData parse_country(std::istream& json_stream, DocumentArena& arena, FieldSet fields)
+{
+  return detail::arena_state(arena).parse([&json_stream, fields](detail::ArenaDocument& document) {
+    rapidjson::IStreamWrapper stream_wrapper{json_stream};
+    document.ParseStream<rapidjson::kParseFullPrecisionFlag>(stream_wrapper);
+    return parse_country_dom<CountryData>(document, fields);
+  });
+}
+
+CountryListObject parse_countries(std::istream& json_stream, DocumentArena& arena)
+{
+  return detail::arena_state(arena).parse([&json_stream](detail::ArenaDocument& document) {
+    rapidjson::IStreamWrapper stream_wrapper{json_stream};
+    document.ParseStream(stream_wrapper);
+    return parse_countries_dom<CountryListObject>(document);
+  });
+}
+
+Timeline parse_timeline(std::istream& json_stream, DocumentArena& arena)
+{
+  return detail::arena_state(arena).parse([&json_stream](detail::ArenaDocument& document) {
+    rapidjson::IStreamWrapper stream_wrapper{json_stream};
+    document.ParseStream(stream_wrapper);
+    return parse_timeline_dom(document);
+  });
+}
+
+CountryDataView parse_country_insitu(char* json_buffer, DocumentArena& arena)
+{
+  return detail::arena_state(arena).parse([json_buffer](detail::ArenaDocument& document) {
+    document.ParseInsitu<rapidjson::kParseFullPrecisionFlag>(json_buffer);
+    return parse_country_dom<CountryDataView>(document);
+  });
+}
+
+CountryListView parse_countries_insitu(char* json_buffer, DocumentArena& arena)
+{
+  return detail::arena_state(arena).parse([json_buffer](detail::ArenaDocument& document) {
+    document.ParseInsitu(json_buffer);
+    return parse_countries_dom<CountryListView>(document);
+  });
+}
+
+InsituParsed<CountryDataView> parse_country_insitu(std::string json)
+{
+  // The string is moved to the heap, i.e. its characters do not move when the InsituParsed is moved
+  auto json_buffer = std::make_unique<std::string>(std::move(json));
+  auto view = parse_country_insitu(json_buffer->data());
+  return InsituParsed<CountryDataView>{std::move(json_buffer), std::move(view)};
+}
+
+InsituParsed<CountryListView> parse_countries_insitu(std::string json)
+{
+  auto json_buffer = std::make_unique<std::string>(std::move(json));
+  auto view = parse_countries_insitu(json_buffer->data());
+  return InsituParsed<CountryListView>{std::move(json_buffer), std::move(view)};
+}
+
 } // namespace coronan::api_parser
@@ -0,0 +1,586 @@
+#include "corona-api_sax_parser.hpp"
+
+#include "coronan/corona-api_parser.hpp"
+#include "coronan/iso_date.hpp"
+
+#include <array>
+#include <istream>
+#include <optional>
+#include <rapidjson/error/en.h>
+#include <rapidjson/istreamwrapper.h>
+#include <rapidjson/reader.h>
+#include <string_view>
+#include <type_traits>
+#include <variant>
+#include <vector>
+
+namespace coronan::api_parser::sax {
+
+namespace {
+
+enum class Scope
+{
+  root,
+  data,
+  today,
+  latest,
+  calculated,
+  timeline,
+  timeline_point,
+  country_list,
+  country_list_item,
+  skip
+};
+
+constexpr auto is_array_scope = [](Scope scope) { return scope == Scope::timeline || scope == Scope::country_list; };
+
+/**
+ * Target of an ISO 8601 date time string value, stored as seconds since epoch (see iso_date::parse_seconds)
+ */
+struct DateTimeTarget
+{
+  std::optional<int64_t>* seconds{};
+};
+
+using Target =
+    std::variant<std::monostate, std::optional<uint32_t>*, std::optional<double>*, std::string*, DateTimeTarget>;
+
+/**
+ * Common SAX state machine of the handlers. Keeps track of the object/array nesting (scopes), assigns values to the
+ * target of the current key and skips all values and sub trees which are not of interest.
+ *
+ * The Derived handler implements
+ *  - on_key(scope, key): select the value target (set_target) or the scope of a sub tree (expect) for key
+ *  - start_array_element(scope): return the scope of an object element of the array scope
+ *  - on_end(scope) (optional): called when the object/array of scope ends
+ */
+template <typename Derived>
+class HandlerBase : public rapidjson::BaseReaderHandler<rapidjson::UTF8<>, Derived>
+{
+public:
+  bool StartObject()
+  {
+    return start_container(true);
+  }
+
+  bool EndObject(rapidjson::SizeType /*member_count*/)
+  {
+    return end_container();
+  }
+
+  bool StartArray()
+  {
+    return start_container(false);
+  }
+
+  bool EndArray(rapidjson::SizeType /*element_count*/)
+  {
+    return end_container();
+  }
+
+  bool Key(char const* str, rapidjson::SizeType length, bool /*copy*/)
+  {
+    target = std::monostate{};
+    child_scope = Scope::skip;
+    if (auto const scope = current_scope(); scope != Scope::skip)
+    {
+      derived().on_key(scope, std::string_view{str, length});
+    }
+    return true;
+  }
+
+  bool String(char const* str, rapidjson::SizeType length, bool /*copy*/)
+  {
+    if (auto* const text = std::get_if<std::string*>(&target))
+    {
+      (*text)->assign(str, length);
+    }
+    else if (auto* const date_time = std::get_if<DateTimeTarget>(&target))
+    {
+      *date_time->seconds = iso_date::parse_seconds(std::string_view{str, length});
+    }
+    return value_done();
+  }
+
+  bool Int(int value)
+  {
+    return number_value(value);
+  }
+
+  bool Uint(unsigned value)
+  {
+    return number_value(value);
+  }
+
+  bool Int64(int64_t value)
+  {
+    return number_value(value);
+  }
+
+  bool Uint64(uint64_t value)
+  {
+    return number_value(value);
+  }
+
+  bool Double(double value)
+  {
+    return number_value(value);
+  }
+
+  // Null and Bool
+  bool Default()
+  {
+    return value_done();
+  }
+
+  void on_end(Scope /*scope*/)
+  {
+  }
+
+protected:
+  void set_target(Target value_target)
+  {
+    target = value_target;
+  }
+
+  void expect(Scope scope)
+  {
+    child_scope = scope;
+  }
+
+private:
+  Derived& derived()
+  {
+    return static_cast<Derived&>(*this);
+  }
+
+  Scope current_scope() const
+  {
+    return scopes.empty() ? Scope::skip : scopes.back();
+  }
+
+  // Same conversions as the DOM parser: only unsigned values are accepted as unsigned and only floating point values
+  // as double. Any number is accepted as string.
+  template <typename Number>
+  bool number_value(Number value)
+  {
+    if (auto* const text = std::get_if<std::string*>(&target))
+    {
+      **text = std::to_string(value);
+    }
+    else if constexpr (std::is_same_v<Number, unsigned>)
+    {
+      if (auto* const number = std::get_if<std::optional<uint32_t>*>(&target))
+      {
+        **number = value;
+      }
+    }
+    else if constexpr (std::is_same_v<Number, double>)
+    {
+      if (auto* const number = std::get_if<std::optional<double>*>(&target))
+      {
+        **number = value;
+      }
+    }
+    return value_done();
+  }
+
+  bool value_done()
+  {
+    target = std::monostate{};
+    return true;
+  }
+
+  bool start_container(bool is_object)
+  {
+    auto next_scope = Scope::skip;
+    if (scopes.empty())
+    {
+      next_scope = is_object ? Scope::root : Scope::skip;
+    }
+    else if (auto const scope = current_scope(); is_array_scope(scope))
+    {
+      next_scope = is_object ? derived().start_array_element(scope) : Scope::skip;
+    }
+    else if (child_scope != Scope::skip && is_object != is_array_scope(child_scope))
+    {
+      next_scope = child_scope;
+    }
+    scopes.push_back(next_scope);
+    target = std::monostate{};
+    child_scope = Scope::skip;
+    return true;
+  }
+
+  bool end_container()
+  {
+    auto const scope = current_scope();
+    scopes.pop_back();
+    derived().on_end(scope);
+    return true;
+  }
+
+  std::vector<Scope> scopes{};
+  Scope child_scope = Scope::skip;
+  Target target{};
+};
+
+// Skips the sub trees and values of the fields which are not selected
+class CountryDataHandler : public HandlerBase<CountryDataHandler>
+{
+public:
+  explicit CountryDataHandler(FieldSet fields_ = fields::all) : selected{fields_}
+  {
+  }
+
+  void on_key(Scope scope, std::string_view key)
+  {
+    switch (scope)
+    {
+    case Scope::root:
+      on_root_key(key);
+      break;
+    case Scope::data:
+      on_data_key(key);
+      break;
+    case Scope::today:
+      on_today_key(key);
+      break;
+    case Scope::latest:
+      on_latest_key(key);
+      break;
+    case Scope::calculated:
+      on_calculated_key(key);
+      break;
+    case Scope::timeline_point:
+      on_timeline_point_key(key);
+      break;
+    default:
+      break;
+    }
+  }
+
+  Scope start_array_element(Scope /*scope*/)
+  {
+    country_data.timeline.emplace_back();
+    return Scope::timeline_point;
+  }
+
+  void on_end(Scope scope)
+  {
+    if (scope == Scope::data)
+    {
+      if (selected.contains(fields::today))
+      {
+        country_data.today.date = current_date;
+      }
+      if (selected.contains(fields::latest))
+      {
+        country_data.latest.date = current_date;
+      }
+    }
+  }
+
+  CountryData country_data{};
+
+private:
+  void on_root_key(std::string_view key)
+  {
+    if (key == "data")
+    {
+      expect(Scope::data);
+    }
+  }
+
+  void on_data_key(std::string_view key)
+  {
+    if (key == "name" && selected.contains(fields::info))
+    {
+      set_target(&country_data.info.name);
+    }
+    else if (key == "code" && selected.contains(fields::info))
+    {
+      set_target(&country_data.info.iso_code);
+    }
+    else if (key == "population" && selected.contains(fields::info))
+    {
+      set_target(&country_data.info.population);
+    }
+    else if (key == "updated_at" && selected.intersects(fields::today | fields::latest))
+    {
+      set_target(&current_date);
+    }
+    else if (key == "today" && selected.contains(fields::today))
+    {
+      expect(Scope::today);
+    }
+    else if (key == "latest_data" && selected.contains(fields::latest))
+    {
+      expect(Scope::latest);
+    }
+    else if (key == "timeline" && selected.intersects(fields::timeline::all))
+    {
+      expect(Scope::timeline);
+    }
+  }
+
+  void on_today_key(std::string_view key)
+  {
+    auto& today = country_data.today;
+    if (key == "deaths")
+    {
+      set_target(&today.deaths);
+    }
+    else if (key == "confirmed")
+    {
+      set_target(&today.confirmed);
+    }
+  }
+
+  void on_latest_key(std::string_view key)
+  {
+    auto& latest = country_data.latest;
+    if (key == "deaths")
+    {
+      set_target(&latest.deaths);
+    }
+    else if (key == "confirmed")
+    {
+      set_target(&latest.confirmed);
+    }
+    else if (key == "recovered")
+    {
+      set_target(&latest.recovered);
+    }
+    else if (key == "critical")
+    {
+      set_target(&latest.critical);
+    }
+    else if (key == "calculated")
+    {
+      expect(Scope::calculated);
+    }
+  }
+
+  void on_calculated_key(std::string_view key)
+  {
+    auto& latest = country_data.latest;
+    if (key == "death_rate")
+    {
+      set_target(&latest.death_rate);
+    }
+    else if (key == "recovery_rate")
+    {
+      set_target(&latest.recovery_rate);
+    }
+    else if (key == "recovered_vs_death_ratio")
+    {
+      set_target(&latest.recovered_vs_death_ratio);
+    }
+    else if (key == "cases_per_million_population")
+    {
+      set_target(&latest.cases_per_million_population);
+    }
+  }
+
+  void on_timeline_point_key(std::string_view key)
+  {
+    auto& timepoint = country_data.timeline.back();
+    if (key == "updated_at")
+    {
+      set_target(DateTimeTarget{&timepoint.date});
+    }
+    else if (key == "deaths")
+    {
+      set_metric_target(fields::timeline::deaths, &timepoint.deaths);
+    }
+    else if (key == "confirmed")
+    {
+      set_metric_target(fields::timeline::confirmed, &timepoint.confirmed);
+    }
+    else if (key == "recovered")
+    {
+      set_metric_target(fields::timeline::recovered, &timepoint.recovered);
+    }
+    else if (key == "active")
+    {
+      set_metric_target(fields::timeline::active, &timepoint.active);
+    }
+    else if (key == "new_confirmed")
+    {
+      set_metric_target(fields::timeline::new_confirmed, &timepoint.new_confirmed);
+    }
+    else if (key == "new_recovered")
+    {
+      set_metric_target(fields::timeline::new_recovered, &timepoint.new_recovered);
+    }
+    else if (key == "new_deaths")
+    {
+      set_metric_target(fields::timeline::new_deaths, &timepoint.new_deaths);
+    }
+  }
+
+  void set_metric_target(FieldSet metric, std::optional<uint32_t>* value)
+  {
+    if (selected.contains(metric))
+    {
+      set_target(value);
+    }
+  }
+
+  FieldSet selected;
+  std::string current_date{};
+};
+
+class CountryListHandler : public HandlerBase<CountryListHandler>
+{
+public:
+  void on_key(Scope scope, std::string_view key)
+  {
+    if (scope == Scope::root && key == "data")
+    {
+      expect(Scope::country_list);
+    }
+    else if (scope == Scope::country_list_item)
+    {
+      auto& country = country_list.back();
+      if (key == "name")
+      {
+        set_target(&country.name);
+      }
+      else if (key == "code")
+      {
+        set_target(&country.iso_code);
+      }
+    }
+  }
+
+  Scope start_array_element(Scope /*scope*/)
+  {
+    country_list.emplace_back();
+    return Scope::country_list_item;
+  }
+
+  CountryListObject country_list{};
+};
+
+class TimelineHandler : public HandlerBase<TimelineHandler>
+{
+public:
+  void on_key(Scope scope, std::string_view key)
+  {
+    if (scope == Scope::root && key == "data")
+    {
+      expect(Scope::data);
+    }
+    else if (scope == Scope::data && key == "timeline")
+    {
+      expect(Scope::timeline);
+    }
+    else if (scope == Scope::timeline_point)
+    {
+      on_timeline_point_key(key);
+    }
+  }
+
+  Scope start_array_element(Scope /*scope*/)
+  {
+    date.clear();
+    values.fill(std::nullopt);
+    return Scope::timeline_point;
+  }
+
+  void on_end(Scope scope)
+  {
+    if (scope == Scope::timeline_point)
+    {
+      auto const index = timeline.size();
+      timeline.push_back(iso_date::parse_days(date));
+      for (std::size_t metric = 0; metric < values.size(); ++metric)
+      {
+        if (values[metric].has_value())
+        {
+          timeline.set(index, static_cast<Timeline::Metric>(metric), values[metric].value());
+        }
+      }
+    }
+  }
+
+  Timeline timeline{};
+
+private:
+  static constexpr std::array<std::string_view, Timeline::metric_count> metric_keys{
+      "deaths", "confirmed", "active", "recovered", "new_deaths", "new_confirmed", "new_recovered"};
+
+  void on_timeline_point_key(std::string_view key)
+  {
+    if (key == "updated_at")
+    {
+      set_target(&date);
+      return;
+    }
+    for (std::size_t metric = 0; metric < metric_keys.size(); ++metric)
+    {
+      if (key == metric_keys[metric])
+      {
+        set_target(&values[metric]);
+        return;
+      }
+    }
+  }
+
+  // values of the current timeline point, indexed by Timeline::Metric
+  std::string date{};
+  std::array<std::optional<uint32_t>, Timeline::metric_count> values{};
+};
+
+template <unsigned ParseFlags, typename Handler, typename InputStream>
+Handler parse(InputStream& json_stream, Handler handler = Handler{})
+{
+  rapidjson::Reader reader;
+  if (auto const result = reader.Parse<ParseFlags>(json_stream, handler); result.IsError())
+  {
+    throw ParseException{rapidjson::GetParseError_En(result.Code()), result.Offset()};
+  }
+  return handler;
+}
+
+} // namespace
+
+CountryData parse_country(std::string const& json, FieldSet fields)
+{
+  rapidjson::StringStream json_stream{json.c_str()};
+  return parse<rapidjson::kParseFullPrecisionFlag>(json_stream, CountryDataHandler{fields}).country_data;
+}
+
+CountryListObject parse_countries(std::string const& json)
+{
+  rapidjson::StringStream json_stream{json.c_str()};
+  return parse<rapidjson::kParseDefaultFlags, CountryListHandler>(json_stream).country_list;
+}
+
+Timeline parse_timeline(std::string const& json)
+{
+  rapidjson::StringStream json_stream{json.c_str()};
+  return parse<rapidjson::kParseDefaultFlags, TimelineHandler>(json_stream).timeline;
+}
+
+CountryData parse_country(std::istream& json_stream, FieldSet fields)
+{
+  rapidjson::IStreamWrapper stream_wrapper{json_stream};
+  return parse<rapidjson::kParseFullPrecisionFlag>(stream_wrapper, CountryDataHandler{fields}).country_data;
+}
+
+CountryListObject parse_countries(std::istream& json_stream)
+{
+  rapidjson::IStreamWrapper stream_wrapper{json_stream};
+  return parse<rapidjson::kParseDefaultFlags, CountryListHandler>(stream_wrapper).country_list;
+}
+
+Timeline parse_timeline(std::istream& json_stream)
+{
+  rapidjson::IStreamWrapper stream_wrapper{json_stream};
+  return parse<rapidjson::kParseDefaultFlags, TimelineHandler>(stream_wrapper).timeline;
+}
+
+} // namespace coronan::api_parser::sax
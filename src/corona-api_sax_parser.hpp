@@ -0,0 +1,42 @@
+#pragma once
+
+#include "coronan/corona-api_datatypes.hpp"
+
+#include <iosfwd>
+#include <string>
+
+namespace coronan::api_parser::sax {
+
+/**
+ * Parse the selected fields of a json string for country data using the rapidjson SAX (Reader) API, i.e. without
+ * building a DOM.
+ */
+CountryData parse_country(std::string const& json, FieldSet fields);
+
+/**
+ * Parse a json string for a list of country information using the rapidjson SAX (Reader) API.
+ */
+CountryListObject parse_countries(std::string const& json);
+
+/**
+ * Parse the timeline of a json country data string into a columnar Timeline using the rapidjson SAX (Reader) API.
+ */
+Timeline parse_timeline(std::string const& json);
+
+/**
+ * Parse the selected fields of a json stream for country data using the rapidjson SAX (Reader) API while it is read.
+ */
+CountryData parse_country(std::istream& json_stream, FieldSet fields);
+
+/**
+ * Parse a json stream for a list of country information using the rapidjson SAX (Reader) API while it is read.
+ */
+CountryListObject parse_countries(std::istream& json_stream);
+
+/**
+ * Parse the timeline of a json country data stream into a columnar Timeline using the rapidjson SAX (Reader) API while
+ * it is read.
+ */
+Timeline parse_timeline(std::istream& json_stream);
+
+} // namespace coronan::api_parser::sax
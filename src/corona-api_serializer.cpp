@@ -0,0 +1,231 @@
+#include "corona-api_serializer.hpp"
+
+#include <algorithm>
+#include <array>
+#include <istream>
+#include <optional>
+#include <ostream>
+#include <type_traits>
+#include <vector>
+
+namespace coronan::serializer {
+
+namespace {
+
+template <typename Number>
+void write_number(std::ostream& out, Number value)
+{
+  static_assert(std::is_arithmetic_v<Number>);
+  out.write(reinterpret_cast<char const*>(&value), sizeof(value));
+}
+
+template <typename Number>
+bool read_number(std::istream& in, Number& value)
+{
+  static_assert(std::is_arithmetic_v<Number>);
+  return static_cast<bool>(in.read(reinterpret_cast<char*>(&value), sizeof(value)));
+}
+
+template <typename Number>
+void write_optional(std::ostream& out, std::optional<Number> const& value)
+{
+  write_number(out, static_cast<uint8_t>(value.has_value()));
+  if (value.has_value())
+  {
+    write_number(out, value.value());
+  }
+}
+
+template <typename Number>
+bool read_optional(std::istream& in, std::optional<Number>& value)
+{
+  uint8_t has_value = 0;
+  if (!read_number(in, has_value))
+  {
+    return false;
+  }
+  value.reset();
+  if (has_value != 0)
+  {
+    Number number{};
+    if (!read_number(in, number))
+    {
+      return false;
+    }
+    value = number;
+  }
+  return true;
+}
+
+void write_info(std::ostream& out, CountryInfo const& info)
+{
+  write(out, info.name);
+  write(out, info.iso_code);
+  write_optional(out, info.population);
+}
+
+bool read_info(std::istream& in, CountryInfo& info)
+{
+  return read(in, info.name) && read(in, info.iso_code) && read_optional(in, info.population);
+}
+
+void write_timeline_point(std::ostream& out, CountryData::TimelineData const& point)
+{
+  write_optional(out, point.date);
+  write_optional(out, point.deaths);
+  write_optional(out, point.confirmed);
+  write_optional(out, point.active);
+  write_optional(out, point.recovered);
+  write_optional(out, point.new_deaths);
+  write_optional(out, point.new_confirmed);
+  write_optional(out, point.new_recovered);
+}
+
+bool read_timeline_point(std::istream& in, CountryData::TimelineData& point)
+{
+  return read_optional(in, point.date) && read_optional(in, point.deaths) && read_optional(in, point.confirmed) &&
+         read_optional(in, point.active) && read_optional(in, point.recovered) &&
+         read_optional(in, point.new_deaths) && read_optional(in, point.new_confirmed) &&
+         read_optional(in, point.new_recovered);
+}
+
+template <typename Element, typename WriteElement>
+void write_vector(std::ostream& out, std::vector<Element> const& elements, WriteElement&& write_element)
+{
+  write(out, static_cast<uint32_t>(elements.size()));
+  for (auto const& element : elements)
+  {
+    write_element(out, element);
+  }
+}
+
+template <typename Element, typename ReadElement>
+bool read_vector(std::istream& in, std::vector<Element>& elements, ReadElement&& read_element)
+{
+  uint32_t size = 0;
+  if (!read(in, size))
+  {
+    return false;
+  }
+  elements.clear();
+  // Do not trust the size for a reserve, a corrupt file must not trigger a huge allocation
+  for (uint32_t i = 0; i < size; ++i)
+  {
+    if (!read_element(in, elements.emplace_back()))
+    {
+      return false;
+    }
+  }
+  return true;
+}
+
+} // namespace
+
+void write(std::ostream& out, uint32_t value)
+{
+  write_number(out, value);
+}
+
+void write(std::ostream& out, int64_t value)
+{
+  write_number(out, value);
+}
+
+void write(std::ostream& out, std::string const& value)
+{
+  write(out, static_cast<uint32_t>(value.size()));
+  out.write(value.data(), static_cast<std::streamsize>(value.size()));
+}
+
+void write(std::ostream& out, HTTPCacheValidators const& validators)
+{
+  write(out, validators.etag);
+  write(out, validators.last_modified);
+}
+
+void write(std::ostream& out, CountryData const& country_data)
+{
+  write_info(out, country_data.info);
+
+  auto const& today = country_data.today;
+  write(out, today.date);
+  write_optional(out, today.deaths);
+  write_optional(out, today.confirmed);
+
+  auto const& latest = country_data.latest;
+  write(out, latest.date);
+  write_optional(out, latest.deaths);
+  write_optional(out, latest.confirmed);
+  write_optional(out, latest.recovered);
+  write_optional(out, latest.critical);
+  write_optional(out, latest.death_rate);
+  write_optional(out, latest.recovery_rate);
+  write_optional(out, latest.recovered_vs_death_ratio);
+  write_optional(out, latest.cases_per_million_population);
+
+  write_vector(out, country_data.timeline, write_timeline_point);
+}
+
+void write(std::ostream& out, CountryListObject const& country_list)
+{
+  write_vector(out, country_list, write_info);
+}
+
+bool read(std::istream& in, uint32_t& value)
+{
+  return read_number(in, value);
+}
+
+bool read(std::istream& in, int64_t& value)
+{
+  return read_number(in, value);
+}
+
+bool read(std::istream& in, std::string& value)
+{
+  uint32_t size = 0;
+  if (!read(in, size))
+  {
+    return false;
+  }
+  value.clear();
+  // Read in chunks, a corrupt size must not trigger a huge allocation
+  constexpr uint32_t chunk_size = 4096;
+  std::array<char, chunk_size> chunk{};
+  while (size > 0)
+  {
+    auto const count = std::min(size, chunk_size);
+    if (!in.read(chunk.data(), count))
+    {
+      return false;
+    }
+    value.append(chunk.data(), count);
+    size -= count;
+  }
+  return true;
+}
+
+bool read(std::istream& in, HTTPCacheValidators& validators)
+{
+  return read(in, validators.etag) && read(in, validators.last_modified);
+}
+
+bool read(std::istream& in, CountryData& country_data)
+{
+  auto& today = country_data.today;
+  auto& latest = country_data.latest;
+  return read_info(in, country_data.info) && read(in, today.date) && read_optional(in, today.deaths) &&
+         read_optional(in, today.confirmed) && read(in, latest.date) && read_optional(in, latest.deaths) &&
+         read_optional(in, latest.confirmed) && read_optional(in, latest.recovered) &&
+         read_optional(in, latest.critical) && read_optional(in, latest.death_rate) &&
+         read_optional(in, latest.recovery_rate) && read_optional(in, latest.recovered_vs_death_ratio) &&
+         read_optional(in, latest.cases_per_million_population) &&
+         read_vector(in, country_data.timeline, read_timeline_point);
+}
+
+bool read(std::istream& in, CountryListObject& country_list)
+{
+  return read_vector(in, country_list, read_info);
+}
+
+} // namespace coronan::serializer
@@ -0,0 +1,32 @@
+#pragma once
+
+#include "coronan/corona-api_datatypes.hpp"
+#include "coronan/http_client.hpp"
+
+#include <cstdint>
+#include <iosfwd>
+#include <string>
+
+namespace coronan::serializer {
+
+/**
+ * Binary (de)serialization of the corona-api data types, used by the DiskCache.
+ *
+ * Numbers are written in the native byte order, i.e. the format is only meant to be read on the machine it was
+ * written. A read returns false if the stream does not hold a complete value.
+ */
+void write(std::ostream& out, uint32_t value);
+void write(std::ostream& out, int64_t value);
+void write(std::ostream& out, std::string const& value);
+void write(std::ostream& out, HTTPCacheValidators const& validators);
+void write(std::ostream& out, CountryData const& country_data);
+void write(std::ostream& out, CountryListObject const& country_list);
+
+bool read(std::istream& in, uint32_t& value);
+bool read(std::istream& in, int64_t& value);
+bool read(std::istream& in, std::string& value);
+bool read(std::istream& in, HTTPCacheValidators& validators);
+bool read(std::istream& in, CountryData& country_data);
+bool read(std::istream& in, CountryListObject& country_list);
+
+} // namespace coronan::serializer
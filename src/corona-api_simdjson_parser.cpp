@@ -0,0 +1,572 @@
+#include "corona-api_simdjson_parser.hpp"
+
+#include "corona-api_sax_parser.hpp"
+
+#if defined(CORONAN_WITH_SIMDJSON)
+
+#include "coronan/corona-api_parser.hpp"
+#include "coronan/iso_date.hpp"
+
+#include <algorithm>
+#include <array>
+#include <istream>
+#include <iterator>
+#include <limits>
+#include <optional>
+#include <simdjson.h>
+#include <string_view>
+#include <type_traits>
+#include <variant>
+
+namespace coronan::api_parser::on_demand {
+
+namespace {
+
+using simdjson::ondemand::value;
+
+/**
+ * Target of an ISO 8601 date time string value, stored as seconds since epoch (see iso_date::parse_seconds)
+ */
+struct DateTimeTarget
+{
+  std::optional<int64_t>* seconds{};
+};
+
+using Target =
+    std::variant<std::monostate, std::optional<uint32_t>*, std::optional<double>*, std::string*, DateTimeTarget>;
+
+// Same conversions as the DOM and SAX parsers: only unsigned values are accepted as unsigned and only floating point
+// values as double. Any number is accepted as string.
+std::optional<uint32_t> get_uint(value& json_value)
+{
+  uint64_t number{};
+  if (json_value.get_uint64().get(number) != simdjson::SUCCESS || number > std::numeric_limits<uint32_t>::max())
+  {
+    return std::nullopt;
+  }
+  return static_cast<uint32_t>(number);
+}
+
+bool is_floating_point(value& json_value)
+{
+  simdjson::ondemand::number_type type{};
+  return json_value.get_number_type().get(type) == simdjson::SUCCESS &&
+         type == simdjson::ondemand::number_type::floating_point_number;
+}
+
+std::optional<double> get_double(value& json_value)
+{
+  double number{};
+  if (!is_floating_point(json_value) || json_value.get_double().get(number) != simdjson::SUCCESS)
+  {
+    return std::nullopt;
+  }
+  return number;
+}
+
+// The string value of a json value without copying it (valid until the next document is parsed), empty if the value
+// is not a string
+std::string_view get_string_view(value& json_value)
+{
+  std::string_view text{};
+  return json_value.get_string().get(text) == simdjson::SUCCESS ? text : std::string_view{};
+}
+
+std::string get_string(value& json_value)
+{
+  if (std::string_view text{}; json_value.get_string().get(text) == simdjson::SUCCESS)
+  {
+    return std::string{text};
+  }
+  if (double number{}; is_floating_point(json_value) && json_value.get_double().get(number) == simdjson::SUCCESS)
+  {
+    return std::to_string(number);
+  }
+  if (int64_t number{}; json_value.get_int64().get(number) == simdjson::SUCCESS)
+  {
+    return std::to_string(number);
+  }
+  if (uint64_t number{}; json_value.get_uint64().get(number) == simdjson::SUCCESS)
+  {
+    return std::to_string(number);
+  }
+  return "";
+}
+
+void assign(Target const& target, value& json_value)
+{
+  std::visit(
+      [&json_value](auto const target_value) {
+        using Target_T = std::remove_const_t<decltype(target_value)>;
+        if constexpr (std::is_same_v<Target_T, std::optional<uint32_t>*>)
+        {
+          *target_value = get_uint(json_value);
+        }
+        else if constexpr (std::is_same_v<Target_T, std::optional<double>*>)
+        {
+          *target_value = get_double(json_value);
+        }
+        else if constexpr (std::is_same_v<Target_T, std::string*>)
+        {
+          *target_value = get_string(json_value);
+        }
+        else if constexpr (std::is_same_v<Target_T, DateTimeTarget>)
+        {
+          *target_value.seconds = iso_date::parse_seconds(get_string_view(json_value));
+        }
+      },
+      target);
+}
+
+// True if a value was read as the requested type, false if it has another type. Throws if the value is invalid.
+bool succeeded(simdjson::error_code error)
+{
+  if (error != simdjson::SUCCESS && error != simdjson::INCORRECT_TYPE)
+  {
+    throw simdjson::simdjson_error{error};
+  }
+  return error == simdjson::SUCCESS;
+}
+
+/**
+ * Call on_field(key, value) for each member of a json object. Like all On Demand values, the members can only be
+ * visited once and in document order, a value which on_field does not read is skipped.
+ */
+template <typename OnField>
+void for_each_field(simdjson::ondemand::object& json_object, OnField&& on_field)
+{
+  for (auto field : json_object)
+  {
+    std::string_view const key = field.unescaped_key();
+    value json_value = field.value();
+    on_field(key, json_value);
+  }
+}
+
+/**
+ * Call on_object(object) for each object element of a json array. Same as the SAX parser: values which are not objects
+ * are skipped, invalid values throw a simdjson_error.
+ */
+template <typename OnObject>
+void for_each_object(simdjson::ondemand::array& json_array, OnObject&& on_object)
+{
+  for (auto element : json_array)
+  {
+    if (simdjson::ondemand::object json_object{}; succeeded(element.get_object().get(json_object)))
+    {
+      on_object(json_object);
+    }
+  }
+}
+
+template <typename OnObject>
+void if_object(value& json_value, OnObject&& on_object)
+{
+  if (simdjson::ondemand::object json_object{}; succeeded(json_value.get_object().get(json_object)))
+  {
+    on_object(json_object);
+  }
+}
+
+template <typename OnArray>
+void if_array(value& json_value, OnArray&& on_array)
+{
+  if (simdjson::ondemand::array json_array{}; succeeded(json_value.get_array().get(json_array)))
+  {
+    on_array(json_array);
+  }
+}
+
+Target today_target(std::string_view key, CountryData::TodayData& today)
+{
+  if (key == "deaths")
+  {
+    return &today.deaths;
+  }
+  if (key == "confirmed")
+  {
+    return &today.confirmed;
+  }
+  return {};
+}
+
+Target latest_target(std::string_view key, CountryData::LatestData& latest)
+{
+  if (key == "deaths")
+  {
+    return &latest.deaths;
+  }
+  if (key == "confirmed")
+  {
+    return &latest.confirmed;
+  }
+  if (key == "recovered")
+  {
+    return &latest.recovered;
+  }
+  if (key == "critical")
+  {
+    return &latest.critical;
+  }
+  return {};
+}
+
+Target calculated_target(std::string_view key, CountryData::LatestData& latest)
+{
+  if (key == "death_rate")
+  {
+    return &latest.death_rate;
+  }
+  if (key == "recovery_rate")
+  {
+    return &latest.recovery_rate;
+  }
+  if (key == "recovered_vs_death_ratio")
+  {
+    return &latest.recovered_vs_death_ratio;
+  }
+  if (key == "cases_per_million_population")
+  {
+    return &latest.cases_per_million_population;
+  }
+  return {};
+}
+
+Target timeline_point_target(std::string_view key, CountryData::TimelineData& timepoint, FieldSet selected)
+{
+  auto const metric_target = [selected](FieldSet metric, std::optional<uint32_t>* value) {
+    return selected.contains(metric) ? Target{value} : Target{};
+  };
+  if (key == "updated_at")
+  {
+    return DateTimeTarget{&timepoint.date};
+  }
+  if (key == "deaths")
+  {
+    return metric_target(fields::timeline::deaths, &timepoint.deaths);
+  }
+  if (key == "confirmed")
+  {
+    return metric_target(fields::timeline::confirmed, &timepoint.confirmed);
+  }
+  if (key == "recovered")
+  {
+    return metric_target(fields::timeline::recovered, &timepoint.recovered);
+  }
+  if (key == "active")
+  {
+    return metric_target(fields::timeline::active, &timepoint.active);
+  }
+  if (key == "new_confirmed")
+  {
+    return metric_target(fields::timeline::new_confirmed, &timepoint.new_confirmed);
+  }
+  if (key == "new_recovered")
+  {
+    return metric_target(fields::timeline::new_recovered, &timepoint.new_recovered);
+  }
+  if (key == "new_deaths")
+  {
+    return metric_target(fields::timeline::new_deaths, &timepoint.new_deaths);
+  }
+  return {};
+}
+
+void parse_latest_data(simdjson::ondemand::object& latest_object, CountryData::LatestData& latest)
+{
+  for_each_field(latest_object, [&latest](std::string_view key, value& json_value) {
+    if (key == "calculated")
+    {
+      if_object(json_value, [&latest](simdjson::ondemand::object& calculated_object) {
+        for_each_field(calculated_object, [&latest](std::string_view calculated_key, value& calculated_value) {
+          assign(calculated_target(calculated_key, latest), calculated_value);
+        });
+      });
+    }
+    else
+    {
+      assign(latest_target(key, latest), json_value);
+    }
+  });
+}
+
+// Skips the values of the fields which are not selected without converting them
+void parse_country_data(simdjson::ondemand::object& data_object, CountryData& country_data, FieldSet selected)
+{
+  std::string current_date{};
+  for_each_field(data_object, [&country_data, &current_date, selected](std::string_view key, value& json_value) {
+    if (key == "name" && selected.contains(fields::info))
+    {
+      country_data.info.name = get_string(json_value);
+    }
+    else if (key == "code" && selected.contains(fields::info))
+    {
+      country_data.info.iso_code = get_string(json_value);
+    }
+    else if (key == "population" && selected.contains(fields::info))
+    {
+      country_data.info.population = get_uint(json_value);
+    }
+    else if (key == "updated_at" && selected.intersects(fields::today | fields::latest))
+    {
+      current_date = get_string(json_value);
+    }
+    else if (key == "today" && selected.contains(fields::today))
+    {
+      if_object(json_value, [&today = country_data.today](simdjson::ondemand::object& today_object) {
+        for_each_field(today_object, [&today](std::string_view today_key, value& today_value) {
+          assign(today_target(today_key, today), today_value);
+        });
+      });
+    }
+    else if (key == "latest_data" && selected.contains(fields::latest))
+    {
+      if_object(json_value, [&latest = country_data.latest](simdjson::ondemand::object& latest_object) {
+        parse_latest_data(latest_object, latest);
+      });
+    }
+    else if (key == "timeline" && selected.intersects(fields::timeline::all))
+    {
+      if_array(json_value, [&timeline = country_data.timeline, selected](simdjson::ondemand::array& timeline_array) {
+        for_each_object(timeline_array, [&timeline, selected](simdjson::ondemand::object& point_object) {
+          auto& timepoint = timeline.emplace_back();
+          for_each_field(point_object, [&timepoint, selected](std::string_view point_key, value& point_value) {
+            assign(timeline_point_target(point_key, timepoint, selected), point_value);
+          });
+        });
+      });
+    }
+  });
+  if (selected.contains(fields::today))
+  {
+    country_data.today.date = current_date;
+  }
+  if (selected.contains(fields::latest))
+  {
+    country_data.latest.date = current_date;
+  }
+}
+
+constexpr std::array<std::string_view, Timeline::metric_count> metric_keys{
+    "deaths", "confirmed", "active", "recovered", "new_deaths", "new_confirmed", "new_recovered"};
+
+void parse_timeline_point(simdjson::ondemand::object& point_object, Timeline& timeline)
+{
+  std::optional<int32_t> date{};
+  std::array<std::optional<uint32_t>, Timeline::metric_count> values{};
+  for_each_field(point_object, [&date, &values](std::string_view key, value& json_value) {
+    if (key == "updated_at")
+    {
+      date = iso_date::parse_days(get_string_view(json_value));
+      return;
+    }
+    if (auto const metric_key = std::find(metric_keys.begin(), metric_keys.end(), key); metric_key != metric_keys.end())
+    {
+      values[static_cast<std::size_t>(std::distance(metric_keys.begin(), metric_key))] = get_uint(json_value);
+    }
+  });
+
+  auto const index = timeline.size();
+  timeline.push_back(date);
+  for (std::size_t metric = 0; metric < values.size(); ++metric)
+  {
+    if (values[metric].has_value())
+    {
+      timeline.set(index, static_cast<Timeline::Metric>(metric), values[metric].value());
+    }
+  }
+}
+
+/**
+ * Call on_data(value) with the value of the "data" member of the root object of document
+ */
+template <typename OnData>
+void parse_root(simdjson::ondemand::document& document, OnData&& on_data)
+{
+  simdjson::ondemand::object root_object = document.get_object();
+  for_each_field(root_object, [&on_data](std::string_view key, value& json_value) {
+    if (key == "data")
+    {
+      on_data(json_value);
+    }
+  });
+}
+
+// The parser keeps its buffers for the next document, i.e. there is a parser per thread
+simdjson::ondemand::parser& this_thread_parser()
+{
+  thread_local simdjson::ondemand::parser parser{};
+  return parser;
+}
+
+// Offset of the current location of document, i.e. of the value at which the iteration failed
+std::size_t error_offset(simdjson::ondemand::document& document, simdjson::padded_string const& json)
+{
+  char const* location{};
+  if (document.current_location().get(location) != simdjson::SUCCESS)
+  {
+    return json.size();
+  }
+  return static_cast<std::size_t>(location - json.data());
+}
+
+/**
+ * Parse json with parse_document(document) and return its result. Same as the other engines: a ParseException is
+ * thrown if the json is invalid.
+ */
+template <typename Result, typename ParseDocument>
+Result parse(std::string const& json, ParseDocument&& parse_document)
+{
+  // simdjson reads the input in SIMD blocks, i.e. it needs SIMDJSON_PADDING bytes after the json
+  simdjson::padded_string const padded_json{json};
+  simdjson::ondemand::document document{};
+  try
+  {
+    document = this_thread_parser().iterate(padded_json);
+  }
+  catch (simdjson::simdjson_error const& ex)
+  {
+    // The structural errors found before the iteration starts have no location
+    throw ParseException{ex.what(), 0};
+  }
+  try
+  {
+    Result result{};
+    parse_document(document, result);
+    return result;
+  }
+  catch (simdjson::simdjson_error const& ex)
+  {
+    throw ParseException{ex.what(), error_offset(document, padded_json)};
+  }
+}
+
+std::string read_stream(std::istream& json_stream)
+{
+  return std::string{std::istreambuf_iterator<char>{json_stream}, std::istreambuf_iterator<char>{}};
+}
+
+} // namespace
+
+std::string implementation()
+{
+  // Without SIMD instructions simdjson has no advantage over the rapidjson parsers
+  std::string name{simdjson::get_active_implementation()->name()};
+  return name == "fallback" ? std::string{} : name;
+}
+
+CountryData parse_country(std::string const& json, FieldSet fields)
+{
+  return parse<CountryData>(json, [fields](simdjson::ondemand::document& document, CountryData& country_data) {
+    parse_root(document, [&country_data, fields](value& data_value) {
+      if_object(data_value, [&country_data, fields](simdjson::ondemand::object& data_object) {
+        parse_country_data(data_object, country_data, fields);
+      });
+    });
+  });
+}
+
+CountryListObject parse_countries(std::string const& json)
+{
+  return parse<CountryListObject>(json, [](simdjson::ondemand::document& document, CountryListObject& country_list) {
+    parse_root(document, [&country_list](value& data_value) {
+      if_array(data_value, [&country_list](simdjson::ondemand::array& country_array) {
+        for_each_object(country_array, [&country_list](simdjson::ondemand::object& country_object) {
+          auto& country = country_list.emplace_back();
+          for_each_field(country_object, [&country](std::string_view key, value& json_value) {
+            if (key == "name")
+            {
+              country.name = get_string(json_value);
+            }
+            else if (key == "code")
+            {
+              country.iso_code = get_string(json_value);
+            }
+          });
+        });
+      });
+    });
+  });
+}
+
+Timeline parse_timeline(std::string const& json)
+{
+  return parse<Timeline>(json, [](simdjson::ondemand::document& document, Timeline& timeline) {
+    parse_root(document, [&timeline](value& data_value) {
+      if_object(data_value, [&timeline](simdjson::ondemand::object& data_object) {
+        for_each_field(data_object, [&timeline](std::string_view key, value& json_value) {
+          if (key == "timeline")
+          {
+            if_array(json_value, [&timeline](simdjson::ondemand::array& timeline_array) {
+              for_each_object(timeline_array, [&timeline](simdjson::ondemand::object& point_object) {
+                parse_timeline_point(point_object, timeline);
+              });
+            });
+          }
+        });
+      });
+    });
+  });
+}
+
+CountryData parse_country(std::istream& json_stream, FieldSet fields)
+{
+  return parse_country(read_stream(json_stream), fields);
+}
+
+CountryListObject parse_countries(std::istream& json_stream)
+{
+  return parse_countries(read_stream(json_stream));
+}
+
+Timeline parse_timeline(std::istream& json_stream)
+{
+  return parse_timeline(read_stream(json_stream));
+}
+
+} // namespace coronan::api_parser::on_demand
+
+#else
+
+namespace coronan::api_parser::on_demand {
+
+// Built without simdjson (ENABLE_SIMDJSON): the simdjson engine is the SAX engine
+
+std::string implementation()
+{
+  return {};
+}
+
+CountryData parse_country(std::string const& json, FieldSet fields)
+{
+  return sax::parse_country(json, fields);
+}
+
+CountryListObject parse_countries(std::string const& json)
+{
+  return sax::parse_countries(json);
+}
+
+Timeline parse_timeline(std::string const& json)
+{
+  return sax::parse_timeline(json);
+}
+
+CountryData parse_country(std::istream& json_stream, FieldSet fields)
+{
+  return sax::parse_country(json_stream, fields);
+}
+
+CountryListObject parse_countries(std::istream& json_stream)
+{
+  return sax::parse_countries(json_stream);
+}
+
+Timeline parse_timeline(std::istream& json_stream)
+{
+  return sax::parse_timeline(json_stream);
+}
+
+} // namespace coronan::api_parser::on_demand
+
+#endif
@@ -0,0 +1,47 @@
+#pragma once
+
+#include "coronan/corona-api_datatypes.hpp"
+
+#include <iosfwd>
+#include <string>
+
+namespace coronan::api_parser::on_demand {
+
+/**
+ * Return the name of the simdjson implementation selected for the CPU, empty if the CPU supports none of the SIMD
+ * implementations (i.e. simdjson would use its portable fallback implementation).
+ */
+std::string implementation();
+
+/**
+ * Parse the selected fields of a json string for country data using the simdjson On Demand API, i.e. without building
+ * a DOM.
+ */
+CountryData parse_country(std::string const& json, FieldSet fields);
+
+/**
+ * Parse a json string for a list of country information using the simdjson On Demand API.
+ */
+CountryListObject parse_countries(std::string const& json);
+
+/**
+ * Parse the timeline of a json country data string into a columnar Timeline using the simdjson On Demand API.
+ */
+Timeline parse_timeline(std::string const& json);
+
+/**
+ * Read a json stream until its end and parse the selected fields for country data using the simdjson On Demand API.
+ */
+CountryData parse_country(std::istream& json_stream, FieldSet fields);
+
+/**
+ * Read a json stream until its end and parse it for a list of country information using the simdjson On Demand API.
+ */
+CountryListObject parse_countries(std::istream& json_stream);
+
+/**
+ * Read a json stream until its end and parse its timeline into a columnar Timeline using the simdjson On Demand API.
+ */
+Timeline parse_timeline(std::istream& json_stream);
+
+} // namespace coronan::api_parser::on_demand
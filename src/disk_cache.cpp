@@ -0,0 +1,153 @@
+#include "coronan/disk_cache.hpp"
+
+#include "corona-api_serializer.hpp"
+
+#include <Poco/File.h>
+#include <Poco/Path.h>
+#include <Poco/Process.h>
+#include <cctype>
+#include <exception>
+#include <fstream>
+#include <functional>
+#include <sstream>
+#include <string_view>
+#include <thread>
+#include <type_traits>
+
+namespace coronan {
+
+namespace {
+
+constexpr uint32_t cache_file_magic = 0x434E5243; // "CRNC"
+constexpr uint32_t cache_file_version = 3;
+
+template <typename Value>
+constexpr uint32_t value_kind()
+{
+  if constexpr (std::is_same_v<Value, CountryData>)
+  {
+    return 1;
+  }
+  else
+  {
+    static_assert(std::is_same_v<Value, CountryListObject>, "Unsupported cache value type");
+    return 2;
+  }
+}
+
+// Percent-encodes every character of the key but [A-Za-z0-9.-], i.e. distinct keys have distinct file names. The
+// key is stored in the file as well, because names differing in case only name the same file on some file systems.
+std::string file_name(std::string const& key)
+{
+  constexpr auto hex_digits = std::string_view{"0123456789ABCDEF"};
+  std::string name;
+  name.reserve(key.size() + 16);
+  for (auto const character : key)
+  {
+    auto const byte = static_cast<unsigned char>(character);
+    if (std::isalnum(byte) != 0 || character == '-' || character == '.')
+    {
+      name.push_back(character);
+    }
+    else
+    {
+      name.push_back('%');
+      name.push_back(hex_digits[byte >> 4U]);
+      name.push_back(hex_digits[byte & 0x0FU]);
+    }
+  }
+  return name + ".cache";
+}
+
+} // namespace
+
+DiskCache::DiskCache(std::string directory) : directory_{std::move(directory)}
+{
+}
+
+std::string DiskCache::default_directory()
+{
+  return Poco::Path{Poco::Path{Poco::Path::cacheHome()}, "coronan"}.toString();
+}
+
+// cppcheck-suppress unusedFunction
+std::string const& DiskCache::directory() const noexcept
+{
+  return directory_;
+}
+
+std::string DiskCache::file_path(std::string const& key) const
+{
+  return Poco::Path{Poco::Path{directory_}, file_name(key)}.toString();
+}
+
+template <typename Value>
+std::optional<DiskCacheEntry<Value>> DiskCache::load(std::string const& key) const
+{
+  std::ifstream file{file_path(key), std::ios::binary};
+  if (!file)
+  {
+    return std::nullopt;
+  }
+
+  uint32_t magic = 0;
+  uint32_t version = 0;
+  std::string stored_key;
+  uint32_t kind = 0;
+  int64_t stored_at = 0;
+  DiskCacheEntry<Value> entry{};
+  if (!serializer::read(file, magic) || magic != cache_file_magic || !serializer::read(file, version) ||
+      version != cache_file_version || !serializer::read(file, stored_key) || stored_key != key ||
+      !serializer::read(file, kind) || kind != value_kind<Value>() ||
+      !serializer::read(file, entry.validators) || !serializer::read(file, stored_at) ||
+      !serializer::read(file, entry.value))
+  {
+    return std::nullopt;
+  }
+  entry.stored_at = std::chrono::seconds{stored_at};
+  return entry;
+}
+
+template <typename Value>
+bool DiskCache::store(std::string const& key, DiskCacheEntry<Value> const& entry) const
+{
+  try
+  {
+    Poco::File{directory_}.createDirectories();
+
+    // Write to a temporary file first and rename it, so that a concurrent load never sees a partially written file. The
+    // name is unique per process and thread, the cache directory may be shared by several processes.
+    auto const path = file_path(key);
+    std::ostringstream temporary_path;
+    temporary_path << path << ".tmp" << Poco::Process::id() << '.'
+                   << std::hash<std::thread::id>{}(std::this_thread::get_id());
+    {
+      std::ofstream file{temporary_path.str(), std::ios::binary | std::ios::trunc};
+      serializer::write(file, cache_file_magic);
+      serializer::write(file, cache_file_version);
+      serializer::write(file, key);
+      serializer::write(file, value_kind<Value>());
+      serializer::write(file, entry.validators);
+      serializer::write(file, static_cast<int64_t>(entry.stored_at.count()));
+      serializer::write(file, entry.value);
+      if (!file.flush())
+      {
+        Poco::File{temporary_path.str()}.remove();
+        return false;
+      }
+    }
+    Poco::File{temporary_path.str()}.renameTo(path);
+    return true;
+  }
+  catch (std::exception const&)
+  {
+    return false;
+  }
+}
+
+template std::optional<DiskCacheEntry<CountryData>> DiskCache::load<CountryData>(std::string const&) const;
+template std::optional<DiskCacheEntry<CountryListObject>> DiskCache::load<CountryListObject>(std::string const&) const;
+template bool DiskCache::store<CountryData>(std::string const&, DiskCacheEntry<CountryData> const&) const;
+template bool DiskCache::store<CountryListObject>(std::string const&, DiskCacheEntry<CountryListObject> const&) const;
+
+} // namespace coronan
@@ -0,0 +1,140 @@
+#include "coronan/document_arena.hpp"
+
+#include "document_arena_state.hpp"
+
+#include <algorithm>
+#include <atomic>
+
+namespace coronan::api_parser {
+
+namespace {
+
+struct TotalStatistics
+{
+  std::atomic<std::size_t> documents{};
+  std::atomic<std::size_t> bytes_retained{};
+  std::atomic<std::size_t> allocations_avoided{};
+};
+
+TotalStatistics& total_statistics_()
+{
+  static TotalStatistics statistics{};
+  return statistics;
+}
+
+// Headroom for the chunk headers of the pool when a buffer is grown to the size a document needed
+constexpr std::size_t chunk_overhead = 1024;
+
+constexpr auto next_power_of_two = [](std::size_t value) {
+  std::size_t power = 1;
+  while (power < value)
+  {
+    power *= 2;
+  }
+  return power;
+};
+
+} // namespace
+
+namespace detail {
+
+DocumentArenaState& arena_state(DocumentArena& arena) noexcept
+{
+  return *arena.state;
+}
+
+DocumentArenaState::DocumentArenaState(DocumentArenaConfig const& config_) : config{config_}
+{
+  retain(config.chunk_capacity, config.stack_capacity);
+}
+
+DocumentArenaState::~DocumentArenaState()
+{
+  total_statistics_().bytes_retained -= statistics_.bytes_retained;
+}
+
+DocumentArenaStatistics DocumentArenaState::statistics() const noexcept
+{
+  return statistics_;
+}
+
+void DocumentArenaState::release()
+{
+  auto const value_bytes = value_allocator->Size();
+  auto const stack_bytes = stack_allocator->Size();
+  auto const value_fitted = value_allocator->Capacity() <= value_buffer.size();
+  auto const stack_fitted = stack_allocator->Capacity() <= stack_buffer.size();
+
+  auto const avoided = static_cast<std::size_t>(value_fitted) + static_cast<std::size_t>(stack_fitted);
+  ++statistics_.documents;
+  statistics_.allocations_avoided += avoided;
+  auto& total = total_statistics_();
+  ++total.documents;
+  total.allocations_avoided += avoided;
+
+  if (value_fitted && stack_fitted)
+  {
+    value_allocator->Clear();
+    stack_allocator->Clear();
+    return;
+  }
+
+  auto const grown_size = [this](std::size_t buffer_size, std::size_t used_bytes) {
+    return std::clamp(next_power_of_two(used_bytes + chunk_overhead), buffer_size,
+                      std::max(buffer_size, config.max_retained_bytes));
+  };
+  retain(value_fitted ? value_buffer.size() : grown_size(value_buffer.size(), value_bytes),
+         stack_fitted ? stack_buffer.size() : grown_size(stack_buffer.size(), stack_bytes));
+}
+
+void DocumentArenaState::retain(std::size_t value_buffer_size, std::size_t stack_buffer_size)
+{
+  // The pools free their chunks (except the retained buffer) when they are destroyed
+  value_allocator.reset();
+  stack_allocator.reset();
+
+  auto const previously_retained = statistics_.bytes_retained;
+  if (value_buffer.size() != value_buffer_size)
+  {
+    value_buffer = std::vector<char>(value_buffer_size);
+  }
+  if (stack_buffer.size() != stack_buffer_size)
+  {
+    stack_buffer = std::vector<char>(stack_buffer_size);
+  }
+  value_allocator.emplace(value_buffer.data(), value_buffer.size());
+  stack_allocator.emplace(stack_buffer.data(), stack_buffer.size());
+
+  statistics_.bytes_retained = value_buffer.size() + stack_buffer.size();
+  auto& total_bytes_retained = total_statistics_().bytes_retained;
+  total_bytes_retained += statistics_.bytes_retained;
+  total_bytes_retained -= previously_retained;
+}
+
+} // namespace detail
+
+DocumentArena::DocumentArena(DocumentArenaConfig const& config)
+    : state{std::make_unique<detail::DocumentArenaState>(config)}
+{
+}
+
+DocumentArena::~DocumentArena() = default;
+
+DocumentArena& DocumentArena::this_thread()
+{
+  thread_local DocumentArena arena{};
+  return arena;
+}
+
+DocumentArenaStatistics DocumentArena::statistics() const noexcept
+{
+  return state->statistics();
+}
+
+DocumentArenaStatistics DocumentArena::total_statistics() noexcept
+{
+  auto const& total = total_statistics_();
+  return DocumentArenaStatistics{total.documents.load(), total.bytes_retained.load(), total.allocations_avoided.load()};
+}
+
+} // namespace coronan::api_parser
@@ -0,0 +1,71 @@
+#pragma once
+
+#include "coronan/document_arena.hpp"
+
+#include <cstddef>
+#include <optional>
+#include <rapidjson/document.h>
+#include <vector>
+
+namespace coronan::api_parser::detail {
+
+using ArenaAllocator = rapidjson::MemoryPoolAllocator<>;
+using ArenaDocument = rapidjson::GenericDocument<rapidjson::UTF8<>, ArenaAllocator, ArenaAllocator>;
+
+/**
+ * The retained buffers of a DocumentArena. The json values of a document are allocated from a pool whose first chunk
+ * is the retained value buffer, the parse stack from a pool on the retained stack buffer.
+ */
+class DocumentArenaState
+{
+public:
+  explicit DocumentArenaState(DocumentArenaConfig const& config_);
+  ~DocumentArenaState();
+  DocumentArenaState(DocumentArenaState const&) = delete;
+  DocumentArenaState& operator=(DocumentArenaState const&) = delete;
+
+  /**
+   * Call read_document with an empty document allocated in the arena and return its result. The document must not
+   * be used after read_document returned.
+   */
+  template <typename ReadDocument>
+  auto parse(ReadDocument&& read_document)
+  {
+    try
+    {
+      auto result = read_in_document(read_document);
+      release();
+      return result;
+    }
+    catch (...)
+    {
+      release();
+      throw;
+    }
+  }
+
+  DocumentArenaStatistics statistics() const noexcept;
+
+private:
+  static constexpr std::size_t initial_stack_capacity = 1024;
+
+  template <typename ReadDocument>
+  auto read_in_document(ReadDocument& read_document)
+  {
+    ArenaDocument document{&value_allocator.value(), initial_stack_capacity, &stack_allocator.value()};
+    return read_document(document);
+  }
+
+  // Free the pool chunks allocated beyond the retained buffers and grow the buffers which were too small
+  void release();
+  void retain(std::size_t value_buffer_size, std::size_t stack_buffer_size);
+
+  DocumentArenaConfig const config;
+  std::vector<char> value_buffer{};
+  std::vector<char> stack_buffer{};
+  std::optional<ArenaAllocator> value_allocator{};
+  std::optional<ArenaAllocator> stack_allocator{};
+  DocumentArenaStatistics statistics_{};
+};
+
+} // namespace coronan::api_parser::detail
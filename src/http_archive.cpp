@@ -0,0 +1,134 @@
+#include "coronan/http_archive.hpp"
+
+#include "corona-api_serializer.hpp"
+
+#include <cstdint>
+#include <fstream>
+
+namespace coronan {
+
+namespace {
+
+constexpr uint32_t archive_file_magic = 0x414E5243; // "CRNA"
+constexpr uint32_t archive_file_version = 1;
+
+void write_response(std::ostream& out, RecordedResponse const& response)
+{
+  serializer::write(out, static_cast<uint32_t>(response.status));
+  serializer::write(out, response.reason);
+  serializer::write(out, static_cast<uint32_t>(response.headers.size()));
+  for (auto const& [name, value] : response.headers)
+  {
+    serializer::write(out, name);
+    serializer::write(out, value);
+  }
+  serializer::write(out, response.body);
+}
+
+bool read_response(std::istream& in, RecordedResponse& response)
+{
+  uint32_t status = 0;
+  uint32_t header_count = 0;
+  if (!serializer::read(in, status) || !serializer::read(in, response.reason) ||
+      !serializer::read(in, header_count))
+  {
+    return false;
+  }
+  response.status = static_cast<Poco::Net::HTTPResponse::HTTPStatus>(status);
+  response.headers.clear();
+  for (uint32_t i = 0; i < header_count; ++i)
+  {
+    std::string name;
+    std::string value;
+    if (!serializer::read(in, name) || !serializer::read(in, value))
+    {
+      return false;
+    }
+    response.headers.emplace_back(std::move(name), std::move(value));
+  }
+  return serializer::read(in, response.body);
+}
+
+} // namespace
+
+void HTTPArchive::load(std::string const& file_path)
+{
+  auto const error = [&file_path]() {
+    return HTTPClientException{std::string{"Error reading http archive \""} + file_path + "\"."};
+  };
+
+  std::ifstream file{file_path, std::ios::binary};
+  uint32_t magic = 0;
+  uint32_t version = 0;
+  uint32_t response_count = 0;
+  if (!file || !serializer::read(file, magic) || magic != archive_file_magic || !serializer::read(file, version) ||
+      version != archive_file_version || !serializer::read(file, response_count))
+  {
+    throw error();
+  }
+
+  std::unordered_map<std::string, RecordedResponse> loaded_responses;
+  for (uint32_t i = 0; i < response_count; ++i)
+  {
+    std::string url;
+    RecordedResponse response;
+    if (!serializer::read(file, url) || !read_response(file, response))
+    {
+      throw error();
+    }
+    loaded_responses.insert_or_assign(std::move(url), std::move(response));
+  }
+
+  std::lock_guard<std::mutex> const lock{mutex};
+  responses = std::move(loaded_responses);
+}
+
+void HTTPArchive::save(std::string const& file_path) const
+{
+  std::ofstream file{file_path, std::ios::binary | std::ios::trunc};
+  {
+    std::lock_guard<std::mutex> const lock{mutex};
+    serializer::write(file, archive_file_magic);
+    serializer::write(file, archive_file_version);
+    serializer::write(file, static_cast<uint32_t>(responses.size()));
+    for (auto const& [url, response] : responses)
+    {
+      serializer::write(file, url);
+      write_response(file, response);
+    }
+  }
+  if (!file.flush())
+  {
+    throw HTTPClientException{std::string{"Error writing http archive \""} + file_path + "\"."};
+  }
+}
+
+void HTTPArchive::record(std::string const& url, RecordedResponse response)
+{
+  std::lock_guard<std::mutex> const lock{mutex};
+  responses.insert_or_assign(url, std::move(response));
+}
+
+std::optional<RecordedResponse> HTTPArchive::find(std::string const& url) const
+{
+  std::lock_guard<std::mutex> const lock{mutex};
+  if (auto const response_it = responses.find(url); response_it != responses.end())
+  {
+    return response_it->second;
+  }
+  return std::nullopt;
+}
+
+std::size_t HTTPArchive::size() const
+{
+  std::lock_guard<std::mutex> const lock{mutex};
+  return responses.size();
+}
+
+void HTTPArchive::clear()
+{
+  std::lock_guard<std::mutex> const lock{mutex};
+  responses.clear();
+}
+
+} // namespace coronan
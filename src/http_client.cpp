@@ -11,8 +11,9 @@ char const* HTTPClientException::what() const noexcept
   return msg.c_str();
 }
 
-HTTPResponse::HTTPResponse(Poco::Net::HTTPResponse const& response, std::string response_body)
-    : response_{response}, response_body_{std::move(response_body)}
+HTTPResponse::HTTPResponse(Poco::Net::HTTPResponse const& response, std::string response_body,
+                           HTTPTimings const& timings)
+    : response_{response}, response_body_{std::move(response_body)}, timings_{timings}
 {
 }
 
@@ -29,9 +30,24 @@ std::string HTTPResponse::reason() const noexcept
   return response_.getReason();
 }
 
-std::string HTTPResponse::response_body() const noexcept
+std::string const& HTTPResponse::response_body() const noexcept
 {
   return response_body_;
 }
 
+HTTPCacheValidators HTTPResponse::cache_validators() const
+{
+  return HTTPCacheValidators{response_.get("ETag", std::string{}), response_.get("Last-Modified", std::string{})};
+}
+
+HTTPTimings const& HTTPResponse::timings() const noexcept
+{
+  return timings_;
+}
+
+HTTPHeaders HTTPResponse::headers() const
+{
+  return HTTPHeaders{response_.begin(), response_.end()};
+}
+
 } // namespace coronan
@@ -0,0 +1,158 @@
+#include "coronan/http_timing.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <memory>
+#include <utility>
+
+namespace coronan {
+
+namespace {
+
+std::mutex sink_mutex{};
+std::shared_ptr<HTTPTimingSink const> timing_sink{};
+
+std::size_t most_significant_bit(uint64_t value) noexcept
+{
+  std::size_t bit = 0;
+  while (value >>= 1U)
+  {
+    ++bit;
+  }
+  return bit;
+}
+
+} // namespace
+
+std::chrono::nanoseconds phase_duration(HTTPTimings const& timings, HTTPPhase phase) noexcept
+{
+  switch (phase)
+  {
+  case HTTPPhase::checkout:
+    return timings.checkout;
+  case HTTPPhase::send_request:
+    return timings.send_request;
+  case HTTPPhase::time_to_first_byte:
+    return timings.time_to_first_byte;
+  case HTTPPhase::body_transfer:
+    return timings.body_transfer;
+  default:
+    return timings.total;
+  }
+}
+
+void set_http_timing_sink(HTTPTimingSink sink)
+{
+  auto new_sink = sink ? std::make_shared<HTTPTimingSink const>(std::move(sink)) : nullptr;
+  std::lock_guard<std::mutex> const lock{sink_mutex};
+  timing_sink = std::move(new_sink);
+}
+
+void report_http_timings(std::string const& url, HTTPTimings const& timings)
+{
+  auto const sink = std::invoke([]() {
+    std::lock_guard<std::mutex> const lock{sink_mutex};
+    return timing_sink;
+  });
+  if (sink)
+  {
+    (*sink)(url, timings);
+  }
+}
+
+std::size_t LatencyHistogram::bucket_index(uint64_t value) noexcept
+{
+  if (value < sub_bucket_count)
+  {
+    return static_cast<std::size_t>(value);
+  }
+  auto const shift = most_significant_bit(value) - sub_bucket_bits;
+  return (shift + 1) * sub_bucket_count + static_cast<std::size_t>((value >> shift) - sub_bucket_count);
+}
+
+uint64_t LatencyHistogram::bucket_upper_bound(std::size_t index) noexcept
+{
+  if (index < sub_bucket_count)
+  {
+    return index;
+  }
+  auto const shift = index / sub_bucket_count - 1;
+  auto const lower_bound = static_cast<uint64_t>(sub_bucket_count + index % sub_bucket_count) << shift;
+  return lower_bound + ((uint64_t{1} << shift) - 1);
+}
+
+void LatencyHistogram::record(std::chrono::nanoseconds latency) noexcept
+{
+  ++buckets[bucket_index(static_cast<uint64_t>(std::max(latency.count(), std::chrono::nanoseconds::rep{0})))];
+  ++count_;
+}
+
+std::chrono::nanoseconds LatencyHistogram::percentile(double quantile) const noexcept
+{
+  if (count_ == 0)
+  {
+    return std::chrono::nanoseconds{0};
+  }
+  auto const rank = std::max(
+      uint64_t{1}, static_cast<uint64_t>(std::ceil(std::clamp(quantile, 0.0, 1.0) * static_cast<double>(count_))));
+  uint64_t cumulated_count = 0;
+  for (std::size_t index = 0; index < buckets.size(); ++index)
+  {
+    cumulated_count += buckets[index];
+    if (cumulated_count >= rank)
+    {
+      return std::chrono::nanoseconds{static_cast<std::chrono::nanoseconds::rep>(bucket_upper_bound(index))};
+    }
+  }
+  return std::chrono::nanoseconds::max();
+}
+
+std::size_t LatencyHistogram::count() const noexcept
+{
+  return count_;
+}
+
+void HTTPTimingHistograms::record(HTTPTimings const& timings)
+{
+  std::lock_guard<std::mutex> const lock{mutex};
+  for (std::size_t phase = 0; phase < phase_count; ++phase)
+  {
+    histograms[phase].record(phase_duration(timings, static_cast<HTTPPhase>(phase)));
+  }
+  reused_connections_ += timings.connection_reused ? 1 : 0;
+  bytes_received_ += timings.bytes_received;
+}
+
+std::chrono::nanoseconds HTTPTimingHistograms::percentile(HTTPPhase phase, double quantile) const
+{
+  std::lock_guard<std::mutex> const lock{mutex};
+  return histograms[static_cast<std::size_t>(phase)].percentile(quantile);
+}
+
+std::size_t HTTPTimingHistograms::count() const
+{
+  std::lock_guard<std::mutex> const lock{mutex};
+  return histograms[static_cast<std::size_t>(HTTPPhase::total)].count();
+}
+
+std::size_t HTTPTimingHistograms::reused_connections() const
+{
+  std::lock_guard<std::mutex> const lock{mutex};
+  return reused_connections_;
+}
+
+uint64_t HTTPTimingHistograms::bytes_received() const
+{
+  std::lock_guard<std::mutex> const lock{mutex};
+  return bytes_received_;
+}
+
+void HTTPTimingHistograms::clear()
+{
+  std::lock_guard<std::mutex> const lock{mutex};
+  histograms = {};
+  reused_connections_ = 0;
+  bytes_received_ = 0;
+}
+
+} // namespace coronan
@@ -43,4 +43,14 @@ SSLClient::create_with_accept_certificate_handler()
   return ssl_client;
 }
 
+SSLClient&
+// cppcheck-suppress unusedFunction
+SSLClient::shared_with_accept_certificate_handler()
+{
+  // Never destroyed: the TLS sessions of the pooled HTTPS sessions and of the TLS session cache (function local statics
+  // as well) must not outlive the SSL runtime, which would be uninitialized by the destructor of a static client
+  static auto* const shared_client = create_with_accept_certificate_handler().release();
+  return *shared_client;
+}
+
 } // namespace coronan
@@ -12,8 +12,11 @@ Poco::Net::Context::Ptr create_ssl_context()
   constexpr auto load_default_cas = false;
   constexpr auto cipher_list = "ALL:!ADH:!LOW:!EXP:!MD5:@STRENGTH";
   constexpr auto verification_mode = Context::VERIFY_RELAXED;
-  return Context::Ptr{new Context{Context::TLS_CLIENT_USE, private_key_file, certificate_file, ca_location,
-                                  verification_mode, verification_depth, load_default_cas, cipher_list}};
+  auto context = Context::Ptr{new Context{Context::TLS_CLIENT_USE, private_key_file, certificate_file, ca_location,
+                                          verification_mode, verification_depth, load_default_cas, cipher_list}};
+  // Allows HTTPS sessions to resume the TLS session of a previous connection (abbreviated handshake)
+  context->enableSessionCache(true);
+  return context;
 }
 
 } // namespace coronan::ssl_context
@@ -0,0 +1,72 @@
+#include "coronan/thread_pool.hpp"
+
+#include <algorithm>
+
+namespace coronan {
+
+ThreadPool::ThreadPool(std::size_t thread_count)
+{
+  auto const worker_count = std::max<std::size_t>(thread_count, 1);
+  workers.reserve(worker_count);
+  for (std::size_t i = 0; i < worker_count; ++i)
+  {
+    workers.emplace_back([this]() { run(); });
+  }
+}
+
+ThreadPool::~ThreadPool()
+{
+  {
+    std::lock_guard<std::mutex> const lock{mutex};
+    stopping = true;
+  }
+  task_available.notify_all();
+  for (auto& worker : workers)
+  {
+    worker.join();
+  }
+}
+
+// cppcheck-suppress unusedFunction
+std::size_t ThreadPool::size() const noexcept
+{
+  return workers.size();
+}
+
+ThreadPool& ThreadPool::shared()
+{
+  // Never destroyed: pending tasks may use other function local statics (e.g. the HTTP session pools), which would
+  // already be destroyed when the destructor of a static pool waits for them at exit
+  static auto* const pool = new ThreadPool{shared_thread_count};
+  return *pool;
+}
+
+void ThreadPool::enqueue(std::function<void()> task)
+{
+  {
+    std::lock_guard<std::mutex> const lock{mutex};
+    tasks.push_back(std::move(task));
+  }
+  task_available.notify_one();
+}
+
+void ThreadPool::run()
+{
+  while (true)
+  {
+    std::function<void()> task;
+    {
+      std::unique_lock<std::mutex> lock{mutex};
+      task_available.wait(lock, [this]() { return stopping || !tasks.empty(); });
+      if (tasks.empty())
+      {
+        return;
+      }
+      task = std::move(tasks.front());
+      tasks.pop_front();
+    }
+    task();
+  }
+}
+
+} // namespace coronan
@@ -0,0 +1,52 @@
+#include "coronan/tls_session_cache.hpp"
+
+#include <utility>
+
+namespace coronan {
+
+namespace {
+constexpr auto host_key = [](std::string const& host, std::uint16_t port) {
+  return host + ":" + std::to_string(port);
+};
+} // namespace
+
+Poco::Net::Session::Ptr TLSSessionCache::get(std::string const& host, std::uint16_t port) const
+{
+  std::lock_guard<std::mutex> const lock{mutex};
+  auto const session_it = sessions.find(host_key(host, port));
+  return session_it == sessions.cend() ? Poco::Net::Session::Ptr{} : session_it->second;
+}
+
+void TLSSessionCache::handshake_completed(std::string const& host, std::uint16_t port,
+                                          Poco::Net::Session::Ptr session, bool resumed)
+{
+  std::lock_guard<std::mutex> const lock{mutex};
+  if (resumed)
+  {
+    ++statistics_.resumed_handshakes;
+  }
+  else
+  {
+    ++statistics_.full_handshakes;
+  }
+  if (session)
+  {
+    sessions[host_key(host, port)] = std::move(session);
+  }
+}
+
+// cppcheck-suppress unusedFunction
+TLSHandshakeStatistics TLSSessionCache::statistics() const
+{
+  std::lock_guard<std::mutex> const lock{mutex};
+  return statistics_;
+}
+
+// cppcheck-suppress unusedFunction
+void TLSSessionCache::clear()
+{
+  std::lock_guard<std::mutex> const lock{mutex};
+  sessions.clear();
+}
+
+} // namespace coronan
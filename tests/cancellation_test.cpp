@@ -0,0 +1,77 @@
+#include "coronan/cancellation.hpp"
+
+#include <array>
+#include <catch2/catch.hpp>
+#include <ios>
+#include <istream>
+#include <iterator>
+#include <sstream>
+#include <string>
+
+namespace {
+
+TEST_CASE("CancellationToken", "[Cancellation]")
+{
+  SECTION("a default constructed token is never cancelled")
+  {
+    coronan::CancellationToken const testee{};
+
+    REQUIRE_FALSE(testee.can_be_cancelled());
+    REQUIRE_FALSE(testee.is_cancelled());
+    REQUIRE_NOTHROW(testee.throw_if_cancelled());
+  }
+
+  SECTION("a token observes the cancellation of its source")
+  {
+    coronan::CancellationSource source{};
+    auto const testee = source.token();
+
+    REQUIRE(testee.can_be_cancelled());
+    REQUIRE_FALSE(testee.is_cancelled());
+
+    source.cancel();
+
+    REQUIRE(source.is_cancelled());
+    REQUIRE(testee.is_cancelled());
+    REQUIRE_THROWS_AS(testee.throw_if_cancelled(), coronan::OperationCancelledException);
+  }
+
+  SECTION("a token observes only its own source")
+  {
+    coronan::CancellationSource source{};
+    coronan::CancellationSource const other_source{};
+    auto const testee = other_source.token();
+
+    source.cancel();
+
+    REQUIRE_FALSE(testee.is_cancelled());
+  }
+}
+
+TEST_CASE("CancellableStreamBuffer", "[Cancellation]")
+{
+  std::istringstream source{std::string(10000, 'x')};
+  coronan::CancellationSource cancellation_source{};
+  coronan::CancellableStreamBuffer testee{source.rdbuf(), cancellation_source.token()};
+  std::istream stream{&testee};
+  stream.exceptions(std::ios::badbit);
+
+  SECTION("reads the source if not cancelled")
+  {
+    std::string content{std::istreambuf_iterator<char>{stream}, std::istreambuf_iterator<char>{}};
+
+    REQUIRE(content.size() == 10000);
+  }
+
+  SECTION("throws an OperationCancelledException on the next read from the source after the cancellation")
+  {
+    std::array<char, 4096> buffer{};
+    stream.read(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+
+    cancellation_source.cancel();
+
+    REQUIRE_THROWS_AS(stream.get(), coronan::OperationCancelledException);
+  }
+}
+
+} // namespace
@@ -1,10 +1,18 @@
 #include "coronan/corona-api_client.hpp"
 
 #include <Poco/Net/HTTPRequest.h>
+#include <Poco/File.h>
 #include <Poco/Net/HTTPResponse.h>
+#include <Poco/Path.h>
+#include <algorithm>
+#include <atomic>
 #include <catch2/catch.hpp>
+#include <chrono>
+#include <future>
 #include <iostream>
 #include <sstream>
+#include <streambuf>
+#include <thread>
 
 namespace {
 
@@ -36,6 +44,171 @@ std::string TestHTTPClient::get_url = "";
 Poco::Net::HTTPResponse::HTTPStatus TestHTTPClient::response_status = Poco::Net::HTTPResponse::HTTP_CONTINUE;
 std::string TestHTTPClient::response_payload = "";
 
+class TestStreamingHTTPClient
+{
+public:
+  template <typename BodyHandler>
+  static coronan::HTTPResponse get_streamed(std::string const& url, BodyHandler&& handle_body)
+  {
+    get_url = url;
+    if (response_status == Poco::Net::HTTPResponse::HTTP_OK)
+    {
+      std::istringstream body{response_payload};
+      handle_body(body);
+    }
+    return coronan::HTTPResponse{Poco::Net::HTTPResponse{response_status}, ""};
+  }
+
+  inline static std::string get_url{};
+  inline static Poco::Net::HTTPResponse::HTTPStatus response_status{Poco::Net::HTTPResponse::HTTP_OK};
+  inline static std::string response_payload{};
+};
+
+class TestBulkHTTPClient
+{
+public:
+  static coronan::HTTPResponse get(std::string const& url)
+  {
+    auto const running = ++running_requests;
+    auto max_running = max_running_requests.load();
+    while (running > max_running && !max_running_requests.compare_exchange_weak(max_running, running))
+    {
+    }
+    std::this_thread::sleep_for(std::chrono::milliseconds{5});
+    --running_requests;
+
+    if (url == "https://corona-api.com/countries")
+    {
+      return coronan::HTTPResponse{Poco::Net::HTTPResponse{Poco::Net::HTTPResponse::HTTP_OK},
+                                   R"({"data":[{"name":"Austria","code":"AT"},{"name":"Unknown","code":"XX"},)"
+                                   R"({"name":"Switzerland","code":"CH"}]})"};
+    }
+    if (auto const country_code = url.substr(url.size() - 2); country_code != "XX")
+    {
+      return coronan::HTTPResponse{Poco::Net::HTTPResponse{Poco::Net::HTTPResponse::HTTP_OK},
+                                   R"({"data":{"name":"Country )" + country_code + R"(","code":")" + country_code +
+                                       R"(","timeline":[]}})"};
+    }
+    return coronan::HTTPResponse{Poco::Net::HTTPResponse{Poco::Net::HTTPResponse::HTTP_NOT_FOUND}, ""};
+  }
+
+  inline static std::atomic<int> running_requests{0};
+  inline static std::atomic<int> max_running_requests{0};
+};
+
+class TestCountingHTTPClient
+{
+public:
+  static coronan::HTTPResponse get(std::string const& url)
+  {
+    ++get_count;
+    if (url == "https://corona-api.com/countries")
+    {
+      return coronan::HTTPResponse{Poco::Net::HTTPResponse{Poco::Net::HTTPResponse::HTTP_OK},
+                                   R"({"data":[{"name":"Austria","code":"AT"}]})"};
+    }
+    auto const country_code = url.substr(url.size() - 2);
+    return coronan::HTTPResponse{Poco::Net::HTTPResponse{Poco::Net::HTTPResponse::HTTP_OK},
+                                 R"({"data":{"name":"Country )" + country_code + R"(","code":")" + country_code +
+                                     R"(","timeline":[]}})"};
+  }
+
+  inline static int get_count{0};
+};
+
+class TestConditionalHTTPClient
+{
+public:
+  static coronan::HTTPResponse get(std::string const& url, coronan::HTTPCacheValidators const& validators)
+  {
+    ++get_count;
+    received_validators = validators;
+    Poco::Net::HTTPResponse response{Poco::Net::HTTPResponse::HTTP_OK};
+    response.set("ETag", etag);
+    if (validators.etag == etag)
+    {
+      response.setStatus(Poco::Net::HTTPResponse::HTTP_NOT_MODIFIED);
+      return coronan::HTTPResponse{response, ""};
+    }
+    auto const country_code = url.substr(url.size() - 2);
+    return coronan::HTTPResponse{response, R"({"data":{"name":"Country )" + country_code + R"(","code":")" +
+                                               country_code + R"(","timeline":[]}})"};
+  }
+
+  inline static int get_count{0};
+  inline static std::string etag{};
+  inline static coronan::HTTPCacheValidators received_validators{};
+};
+
+/**
+ * Stream buffer returning its content in chunks, which cancels the request after the first chunk was read
+ */
+class CancellingStreamBuffer : public std::streambuf
+{
+public:
+  CancellingStreamBuffer(std::string content_, coronan::CancellationSource source_, std::size_t& bytes_read_)
+      : content{std::move(content_)}, source{std::move(source_)}, bytes_read{bytes_read_}
+  {
+  }
+
+protected:
+  int_type underflow() override
+  {
+    if (bytes_read >= content.size())
+    {
+      return traits_type::eof();
+    }
+    if (bytes_read > 0)
+    {
+      source.cancel();
+    }
+    auto const chunk_size = std::min<std::size_t>(1024, content.size() - bytes_read);
+    setg(content.data() + bytes_read, content.data() + bytes_read, content.data() + bytes_read + chunk_size);
+    bytes_read += chunk_size;
+    return traits_type::to_int_type(*gptr());
+  }
+
+private:
+  std::string content;
+  coronan::CancellationSource source;
+  std::size_t& bytes_read;
+};
+
+class TestCancellingStreamingHTTPClient
+{
+public:
+  template <typename BodyHandler>
+  static coronan::HTTPResponse get_streamed(std::string const& /*url*/, BodyHandler&& handle_body)
+  {
+    body_bytes_read = 0;
+    CancellingStreamBuffer body_buffer{R"({"data":{"name":")" + std::string(body_size, 'x') + R"(","code":"CH"}})",
+                                       cancellation_source, body_bytes_read};
+    std::istream body{&body_buffer};
+    handle_body(body);
+    return coronan::HTTPResponse{Poco::Net::HTTPResponse{Poco::Net::HTTPResponse::HTTP_OK}, ""};
+  }
+
+  static constexpr std::size_t body_size = 64 * 1024;
+  inline static coronan::CancellationSource cancellation_source{};
+  inline static std::size_t body_bytes_read{0};
+};
+
+struct TestClock
+{
+  using duration = std::chrono::seconds;
+  using rep = duration::rep;
+  using period = duration::period;
+  using time_point = std::chrono::time_point<TestClock>;
+  static constexpr bool is_steady = false;
+
+  static time_point now() noexcept
+  {
+    return current_time;
+  }
+
+  inline static time_point current_time{std::chrono::seconds{1618041600}};
+};
+
 SCENARIO("CoronaAPIClient retrieves country list", "[CoronaAPIClient]")
 {
   GIVEN("A corona-api client")
@@ -186,4 +359,503 @@ SCENARIO("CoronaAPIClient retrieves country data for Switzerland", "[CoronaAPICl
   }
 }
 
+SCENARIO("CoronaAPIClient requests the data from a configured base url", "[CoronaAPIClient]")
+{
+  GIVEN("A corona-api client with the base url of a local server")
+  {
+    TestHTTPClient::get_called = false;
+    TestHTTPClient::get_url = "";
+    TestHTTPClient::response_status = Poco::Net::HTTPResponse::HTTP_OK;
+    auto testee = coronan::CoronaAPIClientType<TestHTTPClient>{"http://localhost:8080"};
+
+    WHEN("the country list is requested")
+    {
+      TestHTTPClient::response_payload = "{ \"data\": [] }";
+      testee.request_countries();
+
+      THEN("the url of the local server is requested.")
+      {
+        REQUIRE(TestHTTPClient::get_was_called_with("http://localhost:8080/countries"));
+      }
+    }
+
+    WHEN("the country data is requested")
+    {
+      TestHTTPClient::response_payload = "{ \"data\": { \"code\": \"CH\" } }";
+      testee.request_country_data("CH");
+
+      THEN("the url of the local server is requested.")
+      {
+        REQUIRE(TestHTTPClient::get_was_called_with("http://localhost:8080/countries/CH"));
+      }
+    }
+  }
+}
+
+SCENARIO("CoronaAPIClient parses the streamed response of a streaming http client", "[CoronaAPIClient]")
+{
+  GIVEN("A corona-api client with a streaming http client")
+  {
+    auto testee = coronan::CoronaAPIClientType<TestStreamingHTTPClient>{};
+
+    WHEN("the http client returns an not OK response status")
+    {
+      TestStreamingHTTPClient::response_status = Poco::Net::HTTPResponse::HTTP_NOT_FOUND;
+      THEN("an exception is thrown")
+      {
+        CHECK_THROWS_AS(testee.request_country_data("CH"), coronan::HTTPClientException);
+      }
+    }
+
+    WHEN("the http client streams a payload with data for Switzerland")
+    {
+      TestStreamingHTTPClient::response_status = Poco::Net::HTTPResponse::HTTP_OK;
+      TestStreamingHTTPClient::response_payload = "{ \
+          \"data\": { \
+              \"name\": \"Switzerland\", \
+              \"code\": \"CH\", \
+              \"population\": 7581000, \
+              \"today\": { \
+                  \"deaths\": 48, \
+                  \"confirmed\": 1059 \
+              }, \
+              \"timeline\": [ ] \
+          } \
+      }";
+
+      auto const country_data = testee.request_country_data("CH");
+      REQUIRE(TestStreamingHTTPClient::get_url == "https://corona-api.com/countries/CH");
+
+      THEN("the country data is returned.")
+      {
+        REQUIRE(country_data.info.name == "Switzerland");
+        REQUIRE(country_data.info.iso_code == "CH");
+        REQUIRE(country_data.info.population == 7581000);
+        REQUIRE(country_data.today.confirmed == 1059);
+      }
+    }
+  }
+}
+
+SCENARIO("CoronaAPIClient fails on a truncated streamed response", "[CoronaAPIClient]")
+{
+  GIVEN("A corona-api client with a streaming http client and a LRU cache policy")
+  {
+    auto testee = coronan::CoronaAPIClientType<TestStreamingHTTPClient, coronan::LRUCachePolicy<>>{
+        coronan::LRUCachePolicy<>{coronan::LRUCacheConfig{2, std::chrono::minutes{5}}}};
+    auto const payload = std::string{"{ \"data\": { \"name\": \"Switzerland\", \"code\": \"CH\", "
+                                     "\"today\": { \"deaths\": 48, \"confirmed\": 1059 }, \"timeline\": [ ] } }"};
+
+    WHEN("the http client streams a truncated payload")
+    {
+      TestStreamingHTTPClient::response_status = Poco::Net::HTTPResponse::HTTP_OK;
+      TestStreamingHTTPClient::response_payload = payload.substr(0, payload.size() / 2);
+
+      THEN("a parse exception is thrown")
+      {
+        CHECK_THROWS_AS(testee.request_country_data("CH"), coronan::api_parser::ParseException);
+      }
+      AND_WHEN("the country data is requested again and the http client streams the complete payload")
+      {
+        CHECK_THROWS(testee.request_country_data("CH"));
+        TestStreamingHTTPClient::get_url = "";
+        TestStreamingHTTPClient::response_payload = payload;
+        auto const country_data = testee.request_country_data("CH");
+
+        THEN("the data is requested again, i.e. nothing was cached for the truncated payload")
+        {
+          REQUIRE(TestStreamingHTTPClient::get_url == "https://corona-api.com/countries/CH");
+          REQUIRE(country_data.info.name == "Switzerland");
+          REQUIRE(country_data.today.confirmed == 1059);
+        }
+      }
+    }
+  }
+}
+
+SCENARIO("CoronaAPIClient retrieves the country data of many countries concurrently", "[CoronaAPIClient]")
+{
+  GIVEN("A corona-api client")
+  {
+    auto testee = coronan::CoronaAPIClientType<TestBulkHTTPClient>{};
+    TestBulkHTTPClient::max_running_requests = 0;
+
+    WHEN("the data of a list of countries is requested")
+    {
+      std::vector<std::string> const country_codes{"AT", "CH", "DE", "FR", "IT", "ES", "PT", "NL"};
+      auto const bulk_data = testee.request_all_country_data(country_codes, 3);
+
+      THEN("the country data is returned in request order")
+      {
+        REQUIRE(bulk_data.errors.empty());
+        REQUIRE(bulk_data.country_data.size() == country_codes.size());
+        for (std::size_t i = 0; i < country_codes.size(); ++i)
+        {
+          REQUIRE(bulk_data.country_data[i].info.iso_code == country_codes[i]);
+        }
+      }
+
+      THEN("not more than the maximum number of concurrent requests are in flight")
+      {
+        REQUIRE(TestBulkHTTPClient::max_running_requests <= 3);
+        REQUIRE(TestBulkHTTPClient::max_running_requests > 1);
+      }
+    }
+
+    WHEN("the data of all countries is requested and a request fails")
+    {
+      auto const bulk_data = testee.request_all_country_data();
+
+      THEN("the data of the successful requests and the error of the failed request are returned")
+      {
+        REQUIRE(bulk_data.country_data.size() == 2);
+        REQUIRE(bulk_data.country_data[0].info.iso_code == "AT");
+        REQUIRE(bulk_data.country_data[1].info.iso_code == "CH");
+        REQUIRE(bulk_data.errors.size() == 1);
+        REQUIRE(bulk_data.errors[0].country_code == "XX");
+        REQUIRE_FALSE(bulk_data.errors[0].message.empty());
+      }
+    }
+  }
+}
+
+SCENARIO("CoronaAPIClient with a LRU cache policy serves repeated requests from the cache", "[CoronaAPIClient]")
+{
+  GIVEN("A corona-api client with a LRU cache")
+  {
+    TestCountingHTTPClient::get_count = 0;
+    auto testee = coronan::CoronaAPIClientType<TestCountingHTTPClient, coronan::LRUCachePolicy<>>{
+        coronan::LRUCachePolicy<>{coronan::LRUCacheConfig{2, std::chrono::minutes{5}}}};
+
+    WHEN("the data of a country is requested twice")
+    {
+      auto const first_data = testee.request_country_data("CH");
+      auto const second_data = testee.request_country_data("CH");
+
+      THEN("the data is fetched once and returned from the cache the second time")
+      {
+        REQUIRE(TestCountingHTTPClient::get_count == 1);
+        REQUIRE(second_data.info.iso_code == first_data.info.iso_code);
+        REQUIRE(testee.cache_policy().country_data_statistics().hits == 1);
+        REQUIRE(testee.cache_policy().country_data_statistics().misses == 1);
+      }
+    }
+
+    WHEN("the country list is requested twice")
+    {
+      testee.request_countries();
+      auto const countries = testee.request_countries();
+
+      THEN("the list is fetched once")
+      {
+        REQUIRE(TestCountingHTTPClient::get_count == 1);
+        REQUIRE(countries.size() == 1);
+        REQUIRE(testee.cache_policy().country_list_statistics().hits == 1);
+      }
+    }
+
+    WHEN("more countries than the cache capacity are requested")
+    {
+      testee.request_country_data("AT");
+      testee.request_country_data("CH");
+      testee.request_country_data("DE");
+      testee.request_country_data("AT");
+
+      THEN("the least recently used country is evicted and fetched again")
+      {
+        REQUIRE(TestCountingHTTPClient::get_count == 4);
+        REQUIRE(testee.cache_policy().country_data_statistics().evictions == 2);
+      }
+    }
+
+    WHEN("selected fields and the complete data of a country are requested")
+    {
+      auto const projected_data = testee.request_country_data("CH", coronan::fields::latest);
+      auto const complete_data = testee.request_country_data("CH");
+      testee.request_country_data("CH", coronan::fields::latest);
+
+      THEN("the projected data is cached apart from the complete data")
+      {
+        REQUIRE(TestCountingHTTPClient::get_count == 2);
+        REQUIRE(projected_data.info.iso_code.empty());
+        REQUIRE(complete_data.info.iso_code == "CH");
+        REQUIRE(testee.cache_policy().country_data_statistics().hits == 1);
+      }
+    }
+  }
+}
+
+SCENARIO("CoronaAPIClient with a disk cache policy revalidates stale entries", "[CoronaAPIClient]")
+{
+  GIVEN("A corona-api client with a disk cache")
+  {
+    auto const cache_directory =
+        Poco::Path{Poco::Path{Poco::Path::temp()}, "coronan_client_disk_cache_test"}.toString();
+    if (auto directory = Poco::File{cache_directory}; directory.exists())
+    {
+      directory.remove(true);
+    }
+    auto const cache_config = coronan::DiskCacheConfig{cache_directory, std::chrono::minutes{5}};
+    using TesteeT = coronan::CoronaAPIClientType<TestConditionalHTTPClient, coronan::DiskCachePolicy<TestClock>>;
+    auto testee = TesteeT{coronan::DiskCachePolicy<TestClock>{cache_config}};
+    TestConditionalHTTPClient::get_count = 0;
+    TestConditionalHTTPClient::etag = "\"v1\"";
+    testee.request_country_data("CH");
+
+    WHEN("the data is requested again before the time to live expired")
+    {
+      auto const country_data = testee.request_country_data("CH");
+
+      THEN("the data is loaded from disk without a request")
+      {
+        REQUIRE(TestConditionalHTTPClient::get_count == 1);
+        REQUIRE(country_data.info.iso_code == "CH");
+        REQUIRE(testee.cache_policy().statistics().hits == 1);
+      }
+    }
+
+    WHEN("another client with the same cache directory requests the data")
+    {
+      auto const other_client = TesteeT{coronan::DiskCachePolicy<TestClock>{cache_config}};
+      auto const country_data = other_client.request_country_data("CH");
+
+      THEN("the data is loaded from disk without a request")
+      {
+        REQUIRE(TestConditionalHTTPClient::get_count == 1);
+        REQUIRE(country_data.info.iso_code == "CH");
+      }
+    }
+
+    WHEN("the data is requested after the time to live expired and did not change")
+    {
+      TestClock::current_time += std::chrono::minutes{6};
+      auto const country_data = testee.request_country_data("CH");
+
+      THEN("a conditional request is sent and the stored data is returned")
+      {
+        REQUIRE(TestConditionalHTTPClient::get_count == 2);
+        REQUIRE(TestConditionalHTTPClient::received_validators.etag == "\"v1\"");
+        REQUIRE(country_data.info.iso_code == "CH");
+        REQUIRE(testee.cache_policy().statistics().revalidations == 1);
+      }
+
+      AND_THEN("the time to live of the entry restarts")
+      {
+        testee.request_country_data("CH");
+        REQUIRE(TestConditionalHTTPClient::get_count == 2);
+      }
+    }
+
+    WHEN("the data is requested after the time to live expired and changed")
+    {
+      TestClock::current_time += std::chrono::minutes{6};
+      TestConditionalHTTPClient::etag = "\"v2\"";
+      auto const country_data = testee.request_country_data("CH");
+
+      THEN("the new data is downloaded and stored")
+      {
+        REQUIRE(TestConditionalHTTPClient::get_count == 2);
+        REQUIRE(country_data.info.iso_code == "CH");
+        REQUIRE(testee.cache_policy().statistics().misses == 2);
+        REQUIRE(testee.cache_policy().disk_cache().load<coronan::CountryData>(
+                                                     "https://corona-api.com/countries/CH")
+                    ->validators.etag == "\"v2\"");
+      }
+    }
+  }
+}
+
+SCENARIO("CoronaAPIClient fails if the server answers HTTP_NOT_MODIFIED without a cached response", "[CoronaAPIClient]")
+{
+  TestConditionalHTTPClient::etag = "";
+
+  GIVEN("A corona-api client without cache")
+  {
+    auto const testee = coronan::CoronaAPIClientType<TestConditionalHTTPClient>{};
+
+    THEN("a http client exception is thrown instead of returning no data")
+    {
+      REQUIRE_THROWS_AS(testee.request_country_data("CH"), coronan::HTTPClientException);
+    }
+  }
+
+  GIVEN("A corona-api client with an empty disk cache")
+  {
+    auto const cache_directory =
+        Poco::Path{Poco::Path{Poco::Path::temp()}, "coronan_client_disk_cache_test"}.toString();
+    if (auto directory = Poco::File{cache_directory}; directory.exists())
+    {
+      directory.remove(true);
+    }
+    auto const testee = coronan::CoronaAPIClientType<TestConditionalHTTPClient, coronan::DiskCachePolicy<TestClock>>{
+        coronan::DiskCachePolicy<TestClock>{coronan::DiskCacheConfig{cache_directory, std::chrono::minutes{5}}}};
+
+    THEN("a http client exception is thrown and nothing is stored")
+    {
+      REQUIRE_THROWS_AS(testee.request_country_data("CH"), coronan::HTTPClientException);
+      REQUIRE_FALSE(testee.cached_country_data("CH").has_value());
+    }
+  }
+}
+
+SCENARIO("CoronaAPIClient returns cached data without a request", "[CoronaAPIClient]")
+{
+  GIVEN("A corona-api client without cache")
+  {
+    auto const testee = coronan::CoronaAPIClientType<TestCountingHTTPClient>{};
+    testee.request_country_data("CH");
+
+    THEN("no cached data is returned")
+    {
+      REQUIRE_FALSE(testee.cached_countries().has_value());
+      REQUIRE_FALSE(testee.cached_country_data("CH").has_value());
+    }
+  }
+
+  GIVEN("A corona-api client with a disk cache")
+  {
+    auto const cache_directory =
+        Poco::Path{Poco::Path{Poco::Path::temp()}, "coronan_client_cached_data_test"}.toString();
+    if (auto directory = Poco::File{cache_directory}; directory.exists())
+    {
+      directory.remove(true);
+    }
+    auto const cache_config = coronan::DiskCacheConfig{cache_directory, std::chrono::minutes{5}};
+    using TesteeT = coronan::CoronaAPIClientType<TestCountingHTTPClient, coronan::DiskCachePolicy<TestClock>>;
+    auto const testee = TesteeT{coronan::DiskCachePolicy<TestClock>{cache_config}};
+
+    WHEN("nothing was requested")
+    {
+      THEN("no cached data is returned")
+      {
+        REQUIRE_FALSE(testee.cached_countries().has_value());
+        REQUIRE_FALSE(testee.cached_country_data("CH").has_value());
+      }
+    }
+
+    WHEN("the data was requested and its time to live expired")
+    {
+      testee.request_countries();
+      testee.request_country_data("CH");
+      TestClock::current_time += std::chrono::minutes{6};
+      TestCountingHTTPClient::get_count = 0;
+
+      THEN("the stored data is returned without a request")
+      {
+        auto const countries = testee.cached_countries();
+        REQUIRE(countries.has_value());
+        REQUIRE(countries->at(0).iso_code == "AT");
+        auto const country_data = testee.cached_country_data("CH");
+        REQUIRE(country_data.has_value());
+        REQUIRE(country_data->info.iso_code == "CH");
+        REQUIRE_FALSE(testee.cached_country_data("AT").has_value());
+        REQUIRE(TestCountingHTTPClient::get_count == 0);
+      }
+    }
+  }
+}
+
+SCENARIO("CoronaAPIClient requests country data asynchronously", "[CoronaAPIClient]")
+{
+  GIVEN("A corona-api client")
+  {
+    TestCountingHTTPClient::get_count = 0;
+    auto const testee = coronan::CoronaAPIClientType<TestCountingHTTPClient>{};
+
+    WHEN("the country data is requested asynchronously")
+    {
+      auto country_data = testee.request_country_data_async("CH");
+
+      THEN("the future returns the country data")
+      {
+        REQUIRE(country_data.get().info.iso_code == "CH");
+        REQUIRE(TestCountingHTTPClient::get_count == 1);
+      }
+    }
+
+    WHEN("the country list is requested asynchronously")
+    {
+      auto countries = testee.request_countries_async();
+
+      THEN("the future returns the country list")
+      {
+        auto const country_list = countries.get();
+        REQUIRE(country_list.size() == 1);
+        REQUIRE(country_list[0].iso_code == "AT");
+      }
+    }
+
+    WHEN("the country data is requested with a completion handler")
+    {
+      std::promise<std::string> completed_country_code;
+      testee.request_country_data_async("AT", [&completed_country_code](std::future<coronan::CountryData> result) {
+        completed_country_code.set_value(result.get().info.iso_code);
+      });
+
+      THEN("the handler is called with the country data")
+      {
+        REQUIRE(completed_country_code.get_future().get() == "AT");
+      }
+    }
+
+    WHEN("the request is cancelled before it starts")
+    {
+      coronan::CancellationSource cancellation_source{};
+      cancellation_source.cancel();
+      auto country_data = testee.request_country_data_async("CH", cancellation_source.token());
+
+      THEN("no request is sent and the future throws an OperationCancelledException")
+      {
+        REQUIRE_THROWS_AS(country_data.get(), coronan::OperationCancelledException);
+        REQUIRE(TestCountingHTTPClient::get_count == 0);
+      }
+    }
+
+    WHEN("the request with a completion handler is cancelled before it starts")
+    {
+      coronan::CancellationSource cancellation_source{};
+      cancellation_source.cancel();
+      std::promise<bool> cancelled;
+      testee.request_country_data_async(
+          "CH",
+          [&cancelled](std::future<coronan::CountryData> result) {
+            try
+            {
+              result.get();
+              cancelled.set_value(false);
+            }
+            catch (coronan::OperationCancelledException const&)
+            {
+              cancelled.set_value(true);
+            }
+          },
+          cancellation_source.token());
+
+      THEN("the handler is called with the cancellation")
+      {
+        REQUIRE(cancelled.get_future().get());
+        REQUIRE(TestCountingHTTPClient::get_count == 0);
+      }
+    }
+  }
+
+  GIVEN("A corona-api client with a streaming http client")
+  {
+    TestCancellingStreamingHTTPClient::cancellation_source = coronan::CancellationSource{};
+    auto const testee = coronan::CoronaAPIClientType<TestCancellingStreamingHTTPClient>{};
+
+    WHEN("the request is cancelled while the response body is received")
+    {
+      auto country_data =
+          testee.request_country_data_async("CH", TestCancellingStreamingHTTPClient::cancellation_source.token());
+
+      THEN("the response body is not received completely and the future throws an OperationCancelledException")
+      {
+        REQUIRE_THROWS_AS(country_data.get(), coronan::OperationCancelledException);
+        REQUIRE(TestCancellingStreamingHTTPClient::body_bytes_read < TestCancellingStreamingHTTPClient::body_size);
+      }
+    }
+  }
+}
+
 } // namespace
@@ -1,11 +1,18 @@
 #include "coronan/corona-api_parser.hpp"
 
 #include <catch2/catch.hpp>
+#include <sstream>
+#include <string>
+#include <utility>
 
 namespace {
 
+using coronan::api_parser::ParserEngine;
+
 TEST_CASE("The corona-api parser parsing a full json", "[corona-api parser")
 {
+  auto const engine = GENERATE(ParserEngine::dom, ParserEngine::sax, ParserEngine::simdjson);
+
   constexpr auto test_json = "{ \
         \"data\": { \
             \"coordinates\": { \
@@ -60,7 +67,7 @@ TEST_CASE("The corona-api parser parsing a full json", "[corona-api parser")
         } \
     }";
 
-  auto json_object = coronan::api_parser::parse_country(test_json);
+  auto json_object = coronan::api_parser::parse_country(test_json, engine);
   SECTION("returns the country data")
   {
     REQUIRE(json_object.info.name == "Switzerland");
@@ -90,7 +97,7 @@ TEST_CASE("The corona-api parser parsing a full json", "[corona-api parser")
 
   SECTION("returns the timeline data ascending")
   {
-    REQUIRE(json_object.timeline[0].date == "2020-04-03T00:20:32.326Z");
+    REQUIRE(json_object.timeline[0].date == 1585873232); // 2020-04-03T00:20:32.326Z
     REQUIRE(json_object.timeline[0].deaths == 536);
     REQUIRE(json_object.timeline[0].confirmed == 18827);
     REQUIRE(json_object.timeline[0].active == 14278);
@@ -98,7 +105,7 @@ TEST_CASE("The corona-api parser parsing a full json", "[corona-api parser")
     REQUIRE(json_object.timeline[0].new_confirmed == 1059);
     REQUIRE(json_object.timeline[0].new_recovered == 1046);
     REQUIRE(json_object.timeline[0].new_deaths == 48);
-    REQUIRE(json_object.timeline[1].date == "2020-04-01T19:58:34.000Z");
+    REQUIRE(json_object.timeline[1].date == 1585771114); // 2020-04-01T19:58:34.000Z
     REQUIRE(json_object.timeline[1].deaths == 488);
     REQUIRE(json_object.timeline[1].confirmed == 17768);
     REQUIRE(json_object.timeline[1].active == 14313);
@@ -111,6 +118,8 @@ TEST_CASE("The corona-api parser parsing a full json", "[corona-api parser")
 
 TEST_CASE("The corona-api parser parsing a partial json", "[corona-api parser")
 {
+  auto const engine = GENERATE(ParserEngine::dom, ParserEngine::sax, ParserEngine::simdjson);
+
   SECTION("with missing population returns no value for population")
   {
     constexpr auto test_json = "{ \
@@ -125,7 +134,7 @@ TEST_CASE("The corona-api parser parsing a partial json", "[corona-api parser")
         } \
     }";
 
-    auto json_object = coronan::api_parser::parse_country(test_json);
+    auto json_object = coronan::api_parser::parse_country(test_json, engine);
 
     REQUIRE_FALSE(json_object.info.population.has_value());
   }
@@ -146,7 +155,7 @@ TEST_CASE("The corona-api parser parsing a partial json", "[corona-api parser")
         } \
     }";
 
-    auto json_object = coronan::api_parser::parse_country(test_json);
+    auto json_object = coronan::api_parser::parse_country(test_json, engine);
 
     REQUIRE(json_object.today.date == "2020-04-03T00:27:34.432Z");
     REQUIRE_FALSE(json_object.today.deaths.has_value());
@@ -169,7 +178,7 @@ TEST_CASE("The corona-api parser parsing a partial json", "[corona-api parser")
             } \
         }";
 
-    auto json_object = coronan::api_parser::parse_country(test_json);
+    auto json_object = coronan::api_parser::parse_country(test_json, engine);
 
     REQUIRE(json_object.latest.date == "2020-04-03T00:27:34.432Z");
     REQUIRE_FALSE(json_object.today.confirmed.has_value());
@@ -198,7 +207,7 @@ TEST_CASE("The corona-api parser parsing a partial json", "[corona-api parser")
             } \
         }";
 
-    auto json_object = coronan::api_parser::parse_country(test_json);
+    auto json_object = coronan::api_parser::parse_country(test_json, engine);
 
     REQUIRE(json_object.latest.date == "");
     REQUIRE_FALSE(json_object.today.confirmed.has_value());
@@ -227,13 +236,179 @@ TEST_CASE("The corona-api parser parsing a partial json", "[corona-api parser")
         } \
     }";
 
-    auto json_object = coronan::api_parser::parse_country(test_json);
+    auto json_object = coronan::api_parser::parse_country(test_json, engine);
     REQUIRE(json_object.timeline.size() == 0);
   }
+
+  SECTION("with reordered, unknown and mistyped timeline members returns the known members of the timeline objects")
+  {
+    constexpr auto test_json = "{ \
+        \"data\": { \
+            \"name\": \"Switzerland\", \
+            \"timeline\": [ \
+                { \
+                    \"new_deaths\": 48, \
+                    \"is_in_progress\": true, \
+                    \"deaths_total\": 1, \
+                    \"confirmed\": -1, \
+                    \"active\": 14278.5, \
+                    \"updated_at\": \"2020-04-03T00:20:32.326Z\", \
+                    \"deaths\": 536 \
+                }, \
+                42 \
+            ] \
+        } \
+    }";
+
+    auto json_object = coronan::api_parser::parse_country(test_json, engine);
+
+    REQUIRE(json_object.timeline.size() == 1);
+    REQUIRE(json_object.timeline[0].date == 1585873232);
+    REQUIRE(json_object.timeline[0].deaths == 536);
+    REQUIRE(json_object.timeline[0].new_deaths == 48);
+    REQUIRE_FALSE(json_object.timeline[0].confirmed.has_value());
+    REQUIRE_FALSE(json_object.timeline[0].active.has_value());
+    REQUIRE_FALSE(json_object.timeline[0].recovered.has_value());
+  }
+}
+
+TEST_CASE("The corona-api parser parsing an invalid json", "[corona-api parser")
+{
+  using coronan::api_parser::ParseException;
+  auto const engine = GENERATE(ParserEngine::dom, ParserEngine::sax, ParserEngine::simdjson);
+
+  SECTION("throws a parse exception for a truncated or empty json")
+  {
+    auto const test_json = GENERATE(
+        std::string{"{ \"data\": { \"name\": \"Switzerland\", \"today\": { \"deaths\": 48"}, std::string{""});
+    CHECK_THROWS_AS(coronan::api_parser::parse_country(test_json, engine), ParseException);
+    CHECK_THROWS_AS(coronan::api_parser::parse_countries(test_json, engine), ParseException);
+    CHECK_THROWS_AS(coronan::api_parser::parse_timeline(test_json, engine), ParseException);
+
+    std::istringstream json_stream{test_json};
+    CHECK_THROWS_AS(coronan::api_parser::parse_country(json_stream, engine), ParseException);
+  }
+
+  SECTION("throws a parse exception with the offset of the error for a malformed country data member")
+  {
+    auto const test_json = std::string{"{ \"data\": { \"name\": \"Switzerland\" \"code\": \"CH\" } }"};
+    try
+    {
+      coronan::api_parser::parse_country(test_json, engine);
+      FAIL("no exception thrown");
+    }
+    catch (ParseException const& ex)
+    {
+      REQUIRE(ex.offset() > 0);
+      REQUIRE(ex.offset() < test_json.size());
+    }
+  }
+}
+
+TEST_CASE("The corona-api parser parsing selected fields", "[corona-api parser")
+{
+  auto const engine = GENERATE(ParserEngine::dom, ParserEngine::sax, ParserEngine::simdjson);
+
+  std::string const country_json = R"({"data":{"name":"Switzerland","code":"CH","population":7581000,)"
+                                   R"("updated_at":"2020-04-03T00:27:34.432Z","today":{"deaths":54,"confirmed":1059},)"
+                                   R"("latest_data":{"deaths":536,"calculated":{"death_rate":2.84}},)"
+                                   R"("timeline":[{"updated_at":"2020-04-03T00:20:32.326Z","deaths":536,)"
+                                   R"("confirmed":18827}]}})";
+
+  SECTION("returns the latest data and a timeline metric")
+  {
+    auto const country_data = coronan::api_parser::parse_country(
+        country_json, coronan::fields::latest | coronan::fields::timeline::confirmed, engine);
+
+    REQUIRE(country_data.info.name.empty());
+    REQUIRE_FALSE(country_data.info.population.has_value());
+    REQUIRE_FALSE(country_data.today.deaths.has_value());
+    REQUIRE(country_data.today.date.empty());
+    REQUIRE(country_data.latest.date == "2020-04-03T00:27:34.432Z");
+    REQUIRE(country_data.latest.deaths == 536);
+    REQUIRE(country_data.latest.death_rate == 2.84);
+    REQUIRE(country_data.timeline.size() == 1);
+    REQUIRE(country_data.timeline[0].date == 1585873232);
+    REQUIRE(country_data.timeline[0].confirmed == 18827);
+    REQUIRE_FALSE(country_data.timeline[0].deaths.has_value());
+  }
+
+  SECTION("without timeline metrics returns no timeline")
+  {
+    std::istringstream json_stream{country_json};
+    auto const country_data =
+        coronan::api_parser::parse_country(json_stream, coronan::fields::info | coronan::fields::today, engine);
+
+    REQUIRE(country_data.info.name == "Switzerland");
+    REQUIRE(country_data.today.deaths == 54);
+    REQUIRE(country_data.today.date == "2020-04-03T00:27:34.432Z");
+    REQUIRE_FALSE(country_data.latest.deaths.has_value());
+    REQUIRE(country_data.timeline.empty());
+  }
+
+  SECTION("with all fields returns the same as without fields")
+  {
+    auto const country_data = coronan::api_parser::parse_country(country_json, coronan::fields::all, engine);
+    auto const expected = coronan::api_parser::parse_country(country_json, engine);
+
+    REQUIRE(country_data.info.name == expected.info.name);
+    REQUIRE(country_data.latest.death_rate == expected.latest.death_rate);
+    REQUIRE(country_data.timeline[0].deaths == expected.timeline[0].deaths);
+  }
+}
+
+TEST_CASE("The corona-api parser parsing in-situ", "[corona-api parser")
+{
+  std::string const country_json = R"({"data":{"name":"Switzerland","code":"CH","population":7581000,)"
+                                   R"("updated_at":"2020-04-03T00:27:34.432Z","today":{"deaths":54,"confirmed":1059},)"
+                                   R"("latest_data":{"deaths":536,"calculated":{"death_rate":2.84}},)"
+                                   R"("timeline":[{"updated_at":"2020-04-03T00:20:32.326Z","deaths":536}]}})";
+
+  SECTION("returns views into the caller owned buffer")
+  {
+    auto json_buffer = country_json;
+
+    auto const country_data = coronan::api_parser::parse_country_insitu(json_buffer.data());
+
+    REQUIRE(country_data.info.name == "Switzerland");
+    REQUIRE(country_data.info.iso_code == "CH");
+    REQUIRE(country_data.info.name.data() >= json_buffer.data());
+    REQUIRE(country_data.info.name.data() < json_buffer.data() + json_buffer.size());
+    REQUIRE(country_data.info.population == 7581000);
+    REQUIRE(country_data.today.date == "2020-04-03T00:27:34.432Z");
+    REQUIRE(country_data.today.deaths == 54);
+    REQUIRE(country_data.latest.date == "2020-04-03T00:27:34.432Z");
+    REQUIRE(country_data.latest.deaths == 536);
+    REQUIRE(country_data.latest.death_rate == Approx(2.84));
+    REQUIRE(country_data.timeline.size() == 1);
+    REQUIRE(country_data.timeline[0].date == 1585873232);
+  }
+
+  SECTION("returns views into the owned buffer which survive moving the result")
+  {
+    auto parsed = coronan::api_parser::parse_country_insitu(std::string{country_json});
+    auto const moved = std::move(parsed);
+
+    REQUIRE(moved->info.name == "Switzerland");
+    REQUIRE(moved.view().today.date == "2020-04-03T00:27:34.432Z");
+  }
+
+  SECTION("returns views of a country list")
+  {
+    auto const countries = coronan::api_parser::parse_countries_insitu(
+        std::string{R"({"data":[{"name":"Austria","code":"AT"},{"name":"Guinea\/Bissau","code":"GW"}]})"});
+
+    REQUIRE(countries->size() == 2);
+    REQUIRE(countries.view()[0].name == "Austria");
+    REQUIRE(countries.view()[1].name == "Guinea/Bissau");
+    REQUIRE(countries.view()[1].iso_code == "GW");
+  }
 }
 
 TEST_CASE("The corona-api country parser parsing a country list", "[corona-api parser")
 {
+  auto const engine = GENERATE(ParserEngine::dom, ParserEngine::sax, ParserEngine::simdjson);
+
   constexpr auto test_country_json = "{ \
     \"data\": [ \
         { \
@@ -254,7 +429,7 @@ TEST_CASE("The corona-api country parser parsing a country list", "[corona-api p
     ] \
 }";
 
-  auto countries = coronan::api_parser::parse_countries(test_country_json);
+  auto countries = coronan::api_parser::parse_countries(test_country_json, engine);
   SECTION("returns the country data")
   {
     REQUIRE(countries[0].name == "Austria");
@@ -266,4 +441,76 @@ TEST_CASE("The corona-api country parser parsing a country list", "[corona-api p
   }
 }
 
+TEST_CASE("The corona-api timeline parser parsing a country json", "[corona-api parser")
+{
+  auto const engine = GENERATE(ParserEngine::dom, ParserEngine::sax, ParserEngine::simdjson);
+  using Metric = coronan::Timeline::Metric;
+
+  constexpr auto test_json = "{ \
+        \"data\": { \
+            \"name\": \"Switzerland\", \
+            \"code\": \"CH\", \
+            \"timeline\": [ \
+                { \
+                    \"updated_at\": \"2020-04-03T00:20:32.326Z\", \
+                    \"deaths\": 536, \
+                    \"confirmed\": 18827, \
+                    \"active\": 14278, \
+                    \"recovered\": 4013, \
+                    \"new_confirmed\": 1059, \
+                    \"new_recovered\": 1046, \
+                    \"new_deaths\": 48, \
+                    \"is_in_progress\": true \
+                }, \
+                { \
+                    \"updated_at\": \"unknown\", \
+                    \"deaths\": 488, \
+                    \"confirmed\": 17768 \
+                } \
+            ] \
+        } \
+    }";
+
+  auto const timeline = coronan::api_parser::parse_timeline(test_json, engine);
+
+  SECTION("returns a point per timeline entry")
+  {
+    REQUIRE(timeline.size() == 2);
+  }
+
+  SECTION("returns the dates as days since epoch")
+  {
+    REQUIRE(timeline.date(0) == 18355);
+    REQUIRE_FALSE(timeline.date(1).has_value());
+  }
+
+  SECTION("returns the values of the metrics")
+  {
+    REQUIRE(timeline.value(0, Metric::deaths) == 536);
+    REQUIRE(timeline.value(0, Metric::confirmed) == 18827);
+    REQUIRE(timeline.value(0, Metric::active) == 14278);
+    REQUIRE(timeline.value(0, Metric::recovered) == 4013);
+    REQUIRE(timeline.value(0, Metric::new_confirmed) == 1059);
+    REQUIRE(timeline.value(0, Metric::new_recovered) == 1046);
+    REQUIRE(timeline.value(0, Metric::new_deaths) == 48);
+    REQUIRE(timeline.value(1, Metric::deaths) == 488);
+    REQUIRE(timeline.value(1, Metric::confirmed) == 17768);
+  }
+
+  SECTION("returns no value for missing metrics")
+  {
+    REQUIRE_FALSE(timeline.value(1, Metric::active).has_value());
+    REQUIRE_FALSE(timeline.value(1, Metric::new_deaths).has_value());
+  }
+
+  SECTION("parses a stream the same as a string")
+  {
+    std::istringstream json_stream{test_json};
+    auto const streamed_timeline = coronan::api_parser::parse_timeline(json_stream, engine);
+
+    REQUIRE(streamed_timeline.size() == 2);
+    REQUIRE(streamed_timeline.values(Metric::confirmed) == timeline.values(Metric::confirmed));
+  }
+}
+
 } // namespace
@@ -0,0 +1,171 @@
+#include "coronan/corona-api_client.hpp"
+#include "coronan/coroutine.hpp"
+
+#include <Poco/Net/HTTPResponse.h>
+#include <atomic>
+#include <catch2/catch.hpp>
+#include <future>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace {
+
+class TestCoroutineHTTPClient
+{
+public:
+  static coronan::HTTPResponse get(std::string const& url)
+  {
+    ++get_count;
+    auto const country_code = url.substr(url.size() - 2);
+    if (country_code == "XX")
+    {
+      return coronan::HTTPResponse{Poco::Net::HTTPResponse{Poco::Net::HTTPResponse::HTTP_NOT_FOUND}, ""};
+    }
+    return coronan::HTTPResponse{Poco::Net::HTTPResponse{Poco::Net::HTTPResponse::HTTP_OK},
+                                 R"({"data":{"name":"Country )" + country_code + R"(","code":")" + country_code +
+                                     R"(","timeline":[]}})"};
+  }
+
+  inline static std::atomic<int> get_count{0};
+};
+
+coronan::Task<int> answer()
+{
+  co_return 42;
+}
+
+coronan::Task<int> failing_answer()
+{
+  throw std::runtime_error{"failed"};
+  co_return 0;
+}
+
+coronan::Task<int> sum_of_answers()
+{
+  auto const first = co_await answer();
+  auto const second = co_await answer();
+  co_return first + second;
+}
+
+template <typename Client>
+coronan::Task<std::string> request_country_name(Client const& client, std::string country_code,
+                                                coronan::CancellationToken cancellation = {})
+{
+  auto const country_data = co_await client.co_request_country_data(country_code, std::move(cancellation));
+  co_return country_data.info.name;
+}
+
+TEST_CASE("Task", "[Coroutine]")
+{
+  SECTION("returns the result of the coroutine")
+  {
+    REQUIRE(coronan::sync_wait(answer()) == 42);
+  }
+
+  SECTION("awaits other tasks")
+  {
+    REQUIRE(coronan::sync_wait(sum_of_answers()) == 84);
+  }
+
+  SECTION("rethrows the exception of the coroutine")
+  {
+    REQUIRE_THROWS_AS(coronan::sync_wait(failing_answer()), std::runtime_error);
+  }
+
+  SECTION("when_all returns the results of all tasks in task order")
+  {
+    std::vector<coronan::Task<int>> tasks;
+    tasks.push_back(answer());
+    tasks.push_back(failing_answer());
+    tasks.push_back(sum_of_answers());
+
+    auto results = coronan::sync_wait(coronan::when_all(std::move(tasks)));
+
+    REQUIRE(results.size() == 3);
+    REQUIRE(results[0].get() == 42);
+    REQUIRE_THROWS_AS(results[1].get(), std::runtime_error);
+    REQUIRE(results[2].get() == 84);
+  }
+
+  SECTION("when_all of no tasks returns no results")
+  {
+    REQUIRE(coronan::sync_wait(coronan::when_all(std::vector<coronan::Task<int>>{})).empty());
+  }
+}
+
+SCENARIO("CoronaAPIClient requests country data in a coroutine", "[Coroutine]")
+{
+  GIVEN("A corona-api client")
+  {
+    TestCoroutineHTTPClient::get_count = 0;
+    auto const testee = coronan::CoronaAPIClientType<TestCoroutineHTTPClient>{};
+
+    WHEN("the country data is awaited")
+    {
+      auto const country_name = coronan::sync_wait(request_country_name(testee, "CH"));
+
+      THEN("the country data is returned")
+      {
+        REQUIRE(country_name == "Country CH");
+        REQUIRE(TestCoroutineHTTPClient::get_count == 1);
+      }
+    }
+
+    WHEN("a request fails")
+    {
+      THEN("the error is thrown in the coroutine")
+      {
+        REQUIRE_THROWS_AS(coronan::sync_wait(request_country_name(testee, "XX")), coronan::HTTPClientException);
+      }
+    }
+
+    WHEN("a cancelled request is awaited")
+    {
+      coronan::CancellationSource cancellation_source{};
+      cancellation_source.cancel();
+
+      THEN("no request is sent and an OperationCancelledException is thrown in the coroutine")
+      {
+        REQUIRE_THROWS_AS(coronan::sync_wait(request_country_name(testee, "CH", cancellation_source.token())),
+                          coronan::OperationCancelledException);
+        REQUIRE(TestCoroutineHTTPClient::get_count == 0);
+      }
+    }
+
+    WHEN("many requests are awaited concurrently")
+    {
+      constexpr auto request_count = 1000;
+      std::vector<coronan::Task<std::string>> requests;
+      for (auto i = 0; i < request_count; ++i)
+      {
+        requests.push_back(request_country_name(testee, i % 10 == 0 ? "XX" : "CH"));
+      }
+
+      auto country_names = coronan::sync_wait(coronan::when_all(std::move(requests)));
+
+      THEN("all requests complete on the shared thread pool")
+      {
+        REQUIRE(TestCoroutineHTTPClient::get_count == request_count);
+        REQUIRE(country_names.size() == request_count);
+        auto succeeded_requests = 0;
+        auto failed_requests = 0;
+        for (auto& country_name : country_names)
+        {
+          try
+          {
+            succeeded_requests += country_name.get() == "Country CH" ? 1 : 0;
+          }
+          catch (coronan::HTTPClientException const&)
+          {
+            ++failed_requests;
+          }
+        }
+        REQUIRE(succeeded_requests == request_count - request_count / 10);
+        REQUIRE(failed_requests == request_count / 10);
+      }
+    }
+  }
+}
+
+} // namespace
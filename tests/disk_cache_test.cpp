@@ -0,0 +1,133 @@
+#include "coronan/disk_cache.hpp"
+
+#include <Poco/File.h>
+#include <Poco/Path.h>
+#include <catch2/catch.hpp>
+#include <fstream>
+#include <string>
+
+namespace {
+
+using coronan::CountryData;
+using coronan::CountryListObject;
+using coronan::DiskCacheEntry;
+
+auto const test_directory = Poco::Path{Poco::Path{Poco::Path::temp()}, "coronan_disk_cache_test"}.toString();
+
+CountryData create_country_data()
+{
+  CountryData country_data{};
+  country_data.info = coronan::CountryInfo{"Switzerland", "CH", 8654622};
+  country_data.today.date = "2021-04-10T08:00:00.000Z";
+  country_data.today.confirmed = 1059;
+  country_data.latest.date = "2021-04-10T08:00:00.000Z";
+  country_data.latest.deaths = 10253;
+  country_data.latest.death_rate = 1.6283;
+  country_data.timeline.push_back(CountryData::TimelineData{1617942048, 10253, 618847, 4281, 317123,
+                                                            std::nullopt, 1849, 0});
+  country_data.timeline.push_back(CountryData::TimelineData{1617855648});
+  return country_data;
+}
+
+void remove_test_directory()
+{
+  if (auto directory = Poco::File{test_directory}; directory.exists())
+  {
+    directory.remove(true);
+  }
+}
+
+TEST_CASE("DiskCache load and store", "[DiskCache]")
+{
+  remove_test_directory();
+  auto const testee = coronan::DiskCache{test_directory};
+  auto const key = std::string{"https://corona-api.com/countries/CH"};
+
+  SECTION("load returns nothing for an unknown key")
+  {
+    REQUIRE_FALSE(testee.load<CountryData>(key).has_value());
+  }
+
+  SECTION("loads a stored country data entry")
+  {
+    auto const country_data = create_country_data();
+    REQUIRE(testee.store(key, DiskCacheEntry<CountryData>{country_data, {"\"v1\"", "Sat, 10 Apr 2021 08:00:00 GMT"},
+                                                          std::chrono::seconds{1618041600}}));
+
+    auto const entry = testee.load<CountryData>(key);
+
+    REQUIRE(entry.has_value());
+    REQUIRE(entry->validators.etag == "\"v1\"");
+    REQUIRE(entry->validators.last_modified == "Sat, 10 Apr 2021 08:00:00 GMT");
+    REQUIRE(entry->stored_at == std::chrono::seconds{1618041600});
+    auto const& loaded_data = entry->value;
+    REQUIRE(loaded_data.info.name == "Switzerland");
+    REQUIRE(loaded_data.info.iso_code == "CH");
+    REQUIRE(loaded_data.info.population == 8654622);
+    REQUIRE(loaded_data.today.date == country_data.today.date);
+    REQUIRE(loaded_data.today.confirmed == 1059);
+    REQUIRE_FALSE(loaded_data.today.deaths.has_value());
+    REQUIRE(loaded_data.latest.deaths == 10253);
+    REQUIRE(loaded_data.latest.death_rate == 1.6283);
+    REQUIRE(loaded_data.timeline.size() == 2);
+    REQUIRE(loaded_data.timeline[0].date == 1617942048);
+    REQUIRE(loaded_data.timeline[1].date == 1617855648);
+    REQUIRE(loaded_data.timeline[0].confirmed == 618847);
+    REQUIRE(loaded_data.timeline[0].new_confirmed == 1849);
+    REQUIRE_FALSE(loaded_data.timeline[0].new_deaths.has_value());
+    REQUIRE_FALSE(loaded_data.timeline[1].deaths.has_value());
+  }
+
+  SECTION("loads a stored country list entry")
+  {
+    auto const country_list = CountryListObject{{"Austria", "AT", std::nullopt}, {"Switzerland", "CH", 8654622}};
+    REQUIRE(testee.store(key, DiskCacheEntry<CountryListObject>{country_list}));
+
+    auto const entry = testee.load<CountryListObject>(key);
+
+    REQUIRE(entry.has_value());
+    REQUIRE(entry->value.size() == 2);
+    REQUIRE(entry->value[1].iso_code == "CH");
+    REQUIRE(entry->value[1].population == 8654622);
+  }
+
+  SECTION("does not load an entry of another type")
+  {
+    REQUIRE(testee.store(key, DiskCacheEntry<CountryData>{create_country_data()}));
+
+    REQUIRE_FALSE(testee.load<CountryListObject>(key).has_value());
+  }
+
+  SECTION("stores keys differing in their special characters only apart")
+  {
+    auto const slash_key = std::string{"https://corona-api.com/countries/a/b"};
+    auto const underscore_key = std::string{"https://corona-api.com/countries/a_b"};
+    REQUIRE(testee.store(slash_key, DiskCacheEntry<CountryListObject>{{{"Slash", "SL", std::nullopt}}}));
+    REQUIRE(testee.store(underscore_key, DiskCacheEntry<CountryListObject>{{{"Underscore", "UN", std::nullopt}}}));
+
+    REQUIRE(testee.file_path(slash_key) != testee.file_path(underscore_key));
+    REQUIRE(testee.load<CountryListObject>(slash_key)->value[0].iso_code == "SL");
+    REQUIRE(testee.load<CountryListObject>(underscore_key)->value[0].iso_code == "UN");
+  }
+
+  SECTION("does not load the entry of another key")
+  {
+    auto const other_key = std::string{"https://corona-api.com/countries/AT"};
+    REQUIRE(testee.store(key, DiskCacheEntry<CountryData>{create_country_data()}));
+    Poco::File{testee.file_path(key)}.copyTo(testee.file_path(other_key));
+
+    REQUIRE_FALSE(testee.load<CountryData>(other_key).has_value());
+  }
+
+  SECTION("does not load a corrupt entry")
+  {
+    REQUIRE(testee.store(key, DiskCacheEntry<CountryData>{create_country_data()}));
+    std::ofstream{testee.file_path(key), std::ios::binary | std::ios::trunc} << "CRNC garbage";
+
+    REQUIRE_FALSE(testee.load<CountryData>(key).has_value());
+  }
+
+  remove_test_directory();
+}
+
+} // namespace
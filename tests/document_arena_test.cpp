@@ -0,0 +1,117 @@
+#include "coronan/corona-api_parser.hpp"
+#include "coronan/document_arena.hpp"
+
+#include <catch2/catch.hpp>
+#include <sstream>
+#include <string>
+#include <thread>
+
+namespace {
+
+using coronan::api_parser::DocumentArena;
+using coronan::api_parser::DocumentArenaConfig;
+using coronan::api_parser::ParserEngine;
+
+std::string country_json(std::size_t timeline_points)
+{
+  std::string json = R"({"data":{"name":"Switzerland","code":"CH","population":8654622,"timeline":[)";
+  for (std::size_t i = 0; i < timeline_points; ++i)
+  {
+    json += i == 0 ? "" : ",";
+    json += R"({"updated_at":"2020-04-03T00:20:32.326Z","deaths":)" + std::to_string(i) +
+            R"(,"confirmed":18827,"active":14278,"recovered":4013,"new_confirmed":1059,"new_recovered":1046,)" +
+            R"("new_deaths":48})";
+  }
+  return json + "]}}";
+}
+
+TEST_CASE("DocumentArena", "[DocumentArena]")
+{
+  auto const small_json = country_json(2);
+
+  SECTION("parses the same data as the SAX parser")
+  {
+    DocumentArena testee{};
+
+    auto const country_data = coronan::api_parser::parse_country(small_json, testee);
+    auto const expected = coronan::api_parser::parse_country(small_json, ParserEngine::sax);
+
+    REQUIRE(country_data.info.name == expected.info.name);
+    REQUIRE(country_data.timeline.size() == expected.timeline.size());
+    REQUIRE(country_data.timeline[1].deaths == expected.timeline[1].deaths);
+    std::istringstream json_stream{small_json};
+    REQUIRE(coronan::api_parser::parse_timeline(json_stream, testee).size() == 2);
+  }
+
+  SECTION("retains the initial buffers")
+  {
+    DocumentArena const testee{DocumentArenaConfig{4096, 2048, 1024 * 1024}};
+
+    REQUIRE(testee.statistics().bytes_retained == 4096 + 2048);
+    REQUIRE(testee.statistics().documents == 0);
+  }
+
+  SECTION("parses documents which fit into the buffers without allocating")
+  {
+    DocumentArena testee{};
+
+    for (auto i = 0; i < 10; ++i)
+    {
+      coronan::api_parser::parse_country(small_json, testee);
+    }
+
+    REQUIRE(testee.statistics().documents == 10);
+    REQUIRE(testee.statistics().allocations_avoided == 2 * 10);
+    REQUIRE(testee.statistics().bytes_retained == DocumentArenaConfig{}.chunk_capacity +
+                                                       DocumentArenaConfig{}.stack_capacity);
+  }
+
+  SECTION("grows the buffers to the size of a larger document")
+  {
+    DocumentArena testee{DocumentArenaConfig{1024, 1024, 1024 * 1024}};
+    auto const large_json = country_json(200);
+
+    coronan::api_parser::parse_country(large_json, testee);
+    auto const grown_statistics = testee.statistics();
+    coronan::api_parser::parse_country(large_json, testee);
+
+    REQUIRE(grown_statistics.bytes_retained > 1024 + 1024);
+    REQUIRE(grown_statistics.allocations_avoided == 0);
+    REQUIRE(testee.statistics().bytes_retained == grown_statistics.bytes_retained);
+    REQUIRE(testee.statistics().allocations_avoided == 2);
+  }
+
+  SECTION("limits the size of the buffers")
+  {
+    DocumentArena testee{DocumentArenaConfig{1024, 1024, 4096}};
+
+    coronan::api_parser::parse_country(country_json(200), testee);
+
+    REQUIRE(testee.statistics().bytes_retained <= 2 * 4096);
+  }
+
+  SECTION("counts the documents of all arenas")
+  {
+    auto const documents_before = DocumentArena::total_statistics().documents;
+    DocumentArena first{};
+    DocumentArena second{};
+
+    coronan::api_parser::parse_countries(R"({"data":[]})", first);
+    coronan::api_parser::parse_countries(R"({"data":[]})", second);
+
+    REQUIRE(DocumentArena::total_statistics().documents == documents_before + 2);
+  }
+
+  SECTION("the DOM parser uses the arena of the calling thread")
+  {
+    auto const documents_before = DocumentArena::this_thread().statistics().documents;
+
+    coronan::api_parser::parse_country(small_json, ParserEngine::dom);
+    coronan::api_parser::parse_country(small_json, ParserEngine::sax);
+    std::thread{[&small_json]() { coronan::api_parser::parse_country(small_json, ParserEngine::dom); }}.join();
+
+    REQUIRE(DocumentArena::this_thread().statistics().documents == documents_before + 1);
+  }
+}
+
+} // namespace
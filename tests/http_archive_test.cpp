@@ -0,0 +1,230 @@
+#include "coronan/corona-api_client.hpp"
+#include "coronan/http_archive.hpp"
+
+#include <Poco/File.h>
+#include <Poco/Path.h>
+#include <catch2/catch.hpp>
+#include <fstream>
+#include <sstream>
+#include <string>
+
+namespace {
+
+using coronan::ArchiveMode;
+using coronan::RecordedResponse;
+
+auto const test_file = Poco::Path{Poco::Path{Poco::Path::temp()}, "coronan_http_archive_test.bin"}.toString();
+
+void remove_test_file()
+{
+  if (auto file = Poco::File{test_file}; file.exists())
+  {
+    file.remove();
+  }
+}
+
+class TestHTTPClient
+{
+public:
+  static coronan::HTTPResponse get(std::string const& url, coronan::HTTPCacheValidators const& validators = {})
+  {
+    ++get_calls;
+    get_url = url;
+    get_validators = validators;
+    auto response = Poco::Net::HTTPResponse{Poco::Net::HTTPResponse::HTTP_OK, "OK"};
+    response.set("ETag", "\"v1\"");
+    return coronan::HTTPResponse{response, response_payload};
+  }
+
+  template <typename BodyHandler>
+  static coronan::HTTPResponse get_streamed(std::string const& url, BodyHandler&& handle_body,
+                                            coronan::HTTPCacheValidators const& validators = {})
+  {
+    ++get_streamed_calls;
+    get_url = url;
+    get_validators = validators;
+    std::istringstream body{response_payload};
+    handle_body(body);
+    return coronan::HTTPResponse{Poco::Net::HTTPResponse{Poco::Net::HTTPResponse::HTTP_OK, "OK"}, ""};
+  }
+
+  inline static int get_calls{0};
+  inline static int get_streamed_calls{0};
+  inline static std::string get_url{};
+  inline static coronan::HTTPCacheValidators get_validators{};
+  inline static std::string response_payload{};
+};
+
+using TesteeT = coronan::ArchiveHTTPClientType<TestHTTPClient>;
+
+TEST_CASE("HTTPArchive", "[HTTPArchive]")
+{
+  remove_test_file();
+  auto testee = coronan::HTTPArchive{};
+  auto const url = std::string{"https://corona-api.com/countries/CH"};
+
+  SECTION("find returns nothing for an url which was not recorded")
+  {
+    REQUIRE_FALSE(testee.find(url).has_value());
+    REQUIRE(testee.size() == 0);
+  }
+
+  SECTION("finds a recorded response")
+  {
+    testee.record(url, RecordedResponse{Poco::Net::HTTPResponse::HTTP_OK, "OK", {{"ETag", "\"v1\""}}, "{}"});
+
+    auto const response = testee.find(url);
+
+    REQUIRE(response.has_value());
+    REQUIRE(response->status == Poco::Net::HTTPResponse::HTTP_OK);
+    REQUIRE(response->reason == "OK");
+    REQUIRE(response->headers == coronan::HTTPHeaders{{"ETag", "\"v1\""}});
+    REQUIRE(response->body == "{}");
+    REQUIRE(testee.size() == 1);
+  }
+
+  SECTION("loads a saved archive")
+  {
+    testee.record(url, RecordedResponse{Poco::Net::HTTPResponse::HTTP_OK, "OK", {{"ETag", "\"v1\""}}, "{}"});
+    testee.record("https://corona-api.com/countries",
+                  RecordedResponse{Poco::Net::HTTPResponse::HTTP_NOT_FOUND, "Not Found", {}, ""});
+    testee.save(test_file);
+
+    auto loaded = coronan::HTTPArchive{};
+    loaded.load(test_file);
+
+    REQUIRE(loaded.size() == 2);
+    REQUIRE(loaded.find(url)->headers == coronan::HTTPHeaders{{"ETag", "\"v1\""}});
+    REQUIRE(loaded.find(url)->body == "{}");
+    REQUIRE(loaded.find("https://corona-api.com/countries")->status == Poco::Net::HTTPResponse::HTTP_NOT_FOUND);
+  }
+
+  SECTION("load throws for a file which is not an archive")
+  {
+    {
+      std::ofstream file{test_file};
+      file << "no archive";
+    }
+
+    REQUIRE_THROWS_AS(testee.load(test_file), coronan::HTTPClientException);
+  }
+
+  SECTION("load throws for a missing file")
+  {
+    REQUIRE_THROWS_AS(testee.load(test_file), coronan::HTTPClientException);
+  }
+
+  SECTION("clear removes all recorded responses")
+  {
+    testee.record(url, RecordedResponse{});
+
+    testee.clear();
+
+    REQUIRE(testee.size() == 0);
+  }
+  remove_test_file();
+}
+
+TEST_CASE("ArchiveHTTPClientType", "[ArchiveHTTPClientType]")
+{
+  TesteeT::archive().clear();
+  TestHTTPClient::get_calls = 0;
+  TestHTTPClient::get_streamed_calls = 0;
+  TestHTTPClient::response_payload = "{ \"data\": [] }";
+  auto const url = std::string{"https://corona-api.com/countries"};
+
+  SECTION("forwards requests including the cache validators in pass through mode")
+  {
+    TesteeT::set_mode(ArchiveMode::pass_through);
+
+    auto const response = TesteeT::get(url, coronan::HTTPCacheValidators{"\"v0\"", ""});
+
+    REQUIRE(response.response_body() == "{ \"data\": [] }");
+    REQUIRE(TestHTTPClient::get_validators.etag == "\"v0\"");
+    REQUIRE(TesteeT::archive().size() == 0);
+  }
+
+  SECTION("records the responses in record mode")
+  {
+    TesteeT::set_mode(ArchiveMode::record);
+
+    TesteeT::get(url, coronan::HTTPCacheValidators{"\"v0\"", ""});
+
+    auto const recorded = TesteeT::archive().find(url);
+    REQUIRE(recorded.has_value());
+    REQUIRE(recorded->body == "{ \"data\": [] }");
+    REQUIRE(recorded->headers == coronan::HTTPHeaders{{"ETag", "\"v1\""}});
+    REQUIRE(TestHTTPClient::get_validators.etag.empty());
+  }
+
+  SECTION("replays the recorded responses without calling the client in replay mode")
+  {
+    TesteeT::set_mode(ArchiveMode::record);
+    TesteeT::get(url);
+    TestHTTPClient::get_calls = 0;
+    TesteeT::set_mode(ArchiveMode::replay);
+
+    auto const response = TesteeT::get(url);
+
+    REQUIRE(TestHTTPClient::get_calls == 0);
+    REQUIRE(response.status() == Poco::Net::HTTPResponse::HTTP_OK);
+    REQUIRE(response.response_body() == "{ \"data\": [] }");
+    REQUIRE(response.cache_validators().etag == "\"v1\"");
+  }
+
+  SECTION("streams the response body of the client in pass through mode")
+  {
+    TesteeT::set_mode(ArchiveMode::pass_through);
+
+    std::string streamed_body{};
+    TesteeT::get_streamed(
+        url, [&streamed_body](std::istream& body) { std::getline(body, streamed_body); },
+        coronan::HTTPCacheValidators{"\"v0\"", ""});
+
+    REQUIRE(TestHTTPClient::get_streamed_calls == 1);
+    REQUIRE(TestHTTPClient::get_calls == 0);
+    REQUIRE(streamed_body == "{ \"data\": [] }");
+    REQUIRE(TestHTTPClient::get_validators.etag == "\"v0\"");
+  }
+
+  SECTION("passes the complete recorded body to the body handler in record and replay mode")
+  {
+    TesteeT::set_mode(ArchiveMode::record);
+    std::string recorded_body{};
+    TesteeT::get_streamed(url, [&recorded_body](std::istream& body) { std::getline(body, recorded_body); });
+    TesteeT::set_mode(ArchiveMode::replay);
+    std::string replayed_body{};
+    TesteeT::get_streamed(url, [&replayed_body](std::istream& body) { std::getline(body, replayed_body); });
+
+    REQUIRE(TestHTTPClient::get_streamed_calls == 0);
+    REQUIRE(TestHTTPClient::get_calls == 1);
+    REQUIRE(recorded_body == "{ \"data\": [] }");
+    REQUIRE(replayed_body == "{ \"data\": [] }");
+  }
+
+  SECTION("throws in replay mode for an url which was not recorded")
+  {
+    TesteeT::set_mode(ArchiveMode::replay);
+
+    REQUIRE_THROWS_AS(TesteeT::get(url), coronan::HTTPClientException);
+  }
+
+  SECTION("plugs into a CoronaAPIClientType")
+  {
+    TesteeT::set_mode(ArchiveMode::record);
+    TestHTTPClient::response_payload = "{ \"data\": [ { \"name\": \"Switzerland\", \"code\": \"CH\" } ] }";
+    auto const api_client = coronan::CoronaAPIClientType<TesteeT>{};
+    api_client.request_countries();
+    TestHTTPClient::get_calls = 0;
+    TesteeT::set_mode(ArchiveMode::replay);
+
+    auto const countries = api_client.request_countries();
+
+    REQUIRE(TestHTTPClient::get_calls == 0);
+    REQUIRE(countries.size() == 1);
+    REQUIRE(countries[0].iso_code == "CH");
+  }
+  TesteeT::set_mode(ArchiveMode::pass_through);
+}
+
+} // namespace
@@ -2,9 +2,13 @@
 
 #include <Poco/Net/HTTPRequest.h>
 #include <Poco/Net/HTTPResponse.h>
+#include <Poco/Net/NetException.h>
 #include <catch2/catch.hpp>
 #include <iostream>
+#include <map>
+#include <memory>
 #include <sstream>
+#include <stdexcept>
 
 using Poco::Net::HTTPMessage;
 using Poco::Net::HTTPRequest;
@@ -19,11 +23,44 @@ struct TestHTTPRequest
     TestHTTPRequest::request_ = request;
     TestHTTPRequest::type_ = type;
     TestHTTPRequest::path_ = path;
+    TestHTTPRequest::headers_.clear();
   }
 
+  void setKeepAlive(bool keep_alive)
+  {
+    TestHTTPRequest::keep_alive_ = keep_alive;
+  }
+
+  void set(std::string const& name, std::string const& value)
+  {
+    TestHTTPRequest::headers_[name] = value;
+  }
+
+  inline static std::map<std::string, std::string> headers_{};
   inline static std::string request_{};
   inline static std::string type_{};
   inline static std::string path_{};
+  inline static bool keep_alive_{false};
+};
+
+struct TestSocketImpl
+{
+  int sockfd() const
+  {
+    return handle;
+  }
+
+  int handle{0};
+};
+
+struct TestSocket
+{
+  TestSocketImpl* impl() const
+  {
+    return socket_impl.get();
+  }
+
+  std::unique_ptr<TestSocketImpl> socket_impl{std::make_unique<TestSocketImpl>()};
 };
 
 struct TestHTTPSession
@@ -33,20 +70,51 @@ struct TestHTTPSession
   {
     TestHTTPSession::port_ = port;
     TestHTTPSession::host_ = host;
+    ++TestHTTPSession::created_sessions_;
+  }
+
+  void setKeepAlive(bool /*unused*/)
+  {
   }
 
   std::ostream& sendRequest(TestHTTPRequest& /*unused*/)
   {
+    if (is_connected && reconnect_)
+    {
+      // Same as Poco::Net::HTTPSClientSession: a new socket is connected
+      test_socket.socket_impl = std::make_unique<TestSocketImpl>();
+    }
+    is_connected = true;
     return std::cout;
   }
 
+  TestSocket& socket()
+  {
+    return test_socket;
+  }
+
+  bool connected() const
+  {
+    return is_connected;
+  }
+
   std::istream& receiveResponse(HTTPResponse& response)
   {
     if (throw_exception)
     {
       throw exception;
     }
+    if (no_response_ || (close_reused_connections_ && served_requests > 0))
+    {
+      throw Poco::Net::NoMessageException{"No message received"};
+    }
+    ++served_requests;
     response.setStatusAndReason(TestHTTPSession::response_status_, TestHTTPSession::response_reason_);
+    response.setKeepAlive(TestHTTPSession::keep_alive_);
+    for (auto const& [name, value] : TestHTTPSession::response_headers_)
+    {
+      response.set(name, value);
+    }
     return TestHTTPSession::response_;
   }
 
@@ -65,6 +133,11 @@ struct TestHTTPSession
     TestHTTPSession::response_ = std::istringstream{response};
   }
 
+  static void set_keep_alive(bool keep_alive)
+  {
+    TestHTTPSession::keep_alive_ = keep_alive;
+  }
+
   static void set_throw_exception()
   {
     throw_exception = true;
@@ -75,8 +148,17 @@ struct TestHTTPSession
   inline static HTTPResponse::HTTPStatus response_status_{HTTPResponse::HTTP_OK};
   inline static std::string response_reason_{};
   inline static std::istringstream response_{""};
+  inline static bool keep_alive_{false};
+  inline static std::map<std::string, std::string> response_headers_{};
+  inline static int created_sessions_{0};
   inline static bool throw_exception{false};
   inline static std::exception exception{};
+  inline static bool no_response_{false};
+  inline static bool close_reused_connections_{false};
+  inline static bool reconnect_{false};
+  bool is_connected{false};
+  TestSocket test_socket{};
+  int served_requests{0};
 };
 
 using TesteeT = coronan::HTTPClientType<TestHTTPSession, TestHTTPRequest, Poco::Net::HTTPResponse>;
@@ -99,6 +181,7 @@ TEST_CASE("HTTPClient get", "[HTTPClient]")
     REQUIRE(TestHTTPRequest::request_ == HTTPRequest::HTTP_GET);
     REQUIRE(TestHTTPRequest::type_ == HTTPMessage::HTTP_1_1);
     REQUIRE(TestHTTPRequest::path_ == "/test");
+    REQUIRE(TestHTTPRequest::keep_alive_);
   }
 
   SECTION("Returns status, reason and response")
@@ -119,6 +202,232 @@ TEST_CASE("HTTPClient get", "[HTTPClient]")
     REQUIRE(resonse.response_body() == expected_response);
   }
 
+  SECTION("Passes the response body stream of an OK response to the body handler")
+  {
+    TestHTTPSession::set_response_status(HTTPResponse::HTTP_OK);
+    TestHTTPSession::set_response("Test");
+
+    std::string streamed_body{};
+    auto const* uri = "http://server.com:80/test";
+    auto response = TesteeT::get_streamed(uri, [&streamed_body](std::istream& body) { body >> streamed_body; });
+
+    REQUIRE(response.status() == HTTPResponse::HTTP_OK);
+    REQUIRE(streamed_body == "Test");
+    REQUIRE(response.response_body().empty());
+  }
+
+  SECTION("Passes an exception thrown by the body handler through unchanged and closes the connection")
+  {
+    TestHTTPSession::set_response_status(HTTPResponse::HTTP_OK);
+    TestHTTPSession::set_keep_alive(true);
+    TestHTTPSession::set_response("{\"truncated\":");
+
+    auto const* uri = "http://server.com:80/test";
+    auto const throwing_handler = [](std::istream&) { throw std::invalid_argument{"Invalid json"}; };
+    REQUIRE_THROWS_AS(TesteeT::get_streamed(uri, throwing_handler), std::invalid_argument);
+
+    auto const sessions_after_failed_get = TestHTTPSession::created_sessions_;
+    TestHTTPSession::set_response("Test");
+    TesteeT::get(uri);
+    REQUIRE(TestHTTPSession::created_sessions_ == sessions_after_failed_get + 1);
+  }
+
+  SECTION("Returns the response body of a not OK response instead of streaming it")
+  {
+    TestHTTPSession::set_response_status(HTTPResponse::HTTP_NOT_FOUND);
+    TestHTTPSession::set_response("Not found");
+
+    auto body_handler_called = false;
+    auto const* uri = "http://server.com:80/test";
+    auto response = TesteeT::get_streamed(uri, [&body_handler_called](std::istream&) { body_handler_called = true; });
+
+    REQUIRE_FALSE(body_handler_called);
+    REQUIRE(response.status() == HTTPResponse::HTTP_NOT_FOUND);
+    REQUIRE(response.response_body() == "Not found");
+  }
+
+  SECTION("Reuses the session of a kept alive connection")
+  {
+    TestHTTPSession::set_keep_alive(true);
+    TestHTTPSession::set_response("Test");
+
+    auto const* uri = "http://server.com:80/test";
+    auto first_response = TesteeT::get(uri);
+    auto const sessions_after_first_get = TestHTTPSession::created_sessions_;
+    TestHTTPSession::set_response("Test");
+    auto second_response = TesteeT::get(uri);
+
+    REQUIRE(TestHTTPSession::created_sessions_ == sessions_after_first_get);
+    REQUIRE(TesteeT::session_pool().idle_sessions("server.com", 80) == 1);
+
+    TestHTTPSession::set_keep_alive(false);
+    TesteeT::session_pool().clear();
+  }
+
+  SECTION("Does not reuse the session of a closed connection")
+  {
+    TestHTTPSession::set_response("Test");
+
+    auto const* uri = "http://server.com:80/test";
+    auto first_response = TesteeT::get(uri);
+    auto const sessions_after_first_get = TestHTTPSession::created_sessions_;
+    TestHTTPSession::set_response("Test");
+    auto second_response = TesteeT::get(uri);
+
+    REQUIRE(TestHTTPSession::created_sessions_ == sessions_after_first_get + 1);
+    REQUIRE(TesteeT::session_pool().idle_sessions("server.com", 80) == 0);
+  }
+
+  SECTION("Retries a request on a new session if the connection of a reused session was closed")
+  {
+    TestHTTPSession::set_keep_alive(true);
+    TestHTTPSession::set_response("Test");
+
+    auto const* uri = "http://server.com:80/test";
+    auto first_response = TesteeT::get(uri);
+    auto const sessions_after_first_get = TestHTTPSession::created_sessions_;
+    TestHTTPSession::close_reused_connections_ = true;
+    TestHTTPSession::set_response("Retried");
+    auto second_response = TesteeT::get(uri);
+
+    REQUIRE(second_response.response_body() == "Retried");
+    REQUIRE(TestHTTPSession::created_sessions_ == sessions_after_first_get + 1);
+    REQUIRE_FALSE(second_response.timings().connection_reused);
+
+    TestHTTPSession::close_reused_connections_ = false;
+    TestHTTPSession::set_keep_alive(false);
+    TesteeT::session_pool().clear();
+  }
+
+  SECTION("Does not retry a request without response on a new session")
+  {
+    TestHTTPSession::no_response_ = true;
+    auto const sessions_before_get = TestHTTPSession::created_sessions_;
+
+    auto const* uri = "http://server.com:80/test";
+    REQUIRE_THROWS_AS(TesteeT::get(uri), coronan::HTTPClientException);
+    REQUIRE(TestHTTPSession::created_sessions_ == sessions_before_get + 1);
+
+    TestHTTPSession::no_response_ = false;
+  }
+
+  SECTION("Sends a conditional request if cache validators are given")
+  {
+    auto const* uri = "http://server.com:80/test";
+    auto response = TesteeT::get(uri, coronan::HTTPCacheValidators{"\"v1\"", "Sat, 10 Apr 2021 08:00:00 GMT"});
+
+    REQUIRE(TestHTTPRequest::headers_.at("If-None-Match") == "\"v1\"");
+    REQUIRE(TestHTTPRequest::headers_.at("If-Modified-Since") == "Sat, 10 Apr 2021 08:00:00 GMT");
+  }
+
+  SECTION("Sends an unconditional request without cache validators")
+  {
+    auto const* uri = "http://server.com:80/test";
+    auto response = TesteeT::get(uri);
+
+    REQUIRE(TestHTTPRequest::headers_.empty());
+  }
+
+  SECTION("Returns the cache validators of the response")
+  {
+    TestHTTPSession::set_response_status(HTTPResponse::HTTP_NOT_MODIFIED);
+    TestHTTPSession::set_response("");
+    TestHTTPSession::response_headers_ = {{"ETag", "\"v2\""}, {"Last-Modified", "Sun, 11 Apr 2021 08:00:00 GMT"}};
+
+    auto const* uri = "http://server.com:80/test";
+    auto response = TesteeT::get(uri);
+
+    REQUIRE(response.status() == HTTPResponse::HTTP_NOT_MODIFIED);
+    REQUIRE(response.cache_validators().etag == "\"v2\"");
+    REQUIRE(response.cache_validators().last_modified == "Sun, 11 Apr 2021 08:00:00 GMT");
+
+    TestHTTPSession::response_headers_.clear();
+  }
+
+  SECTION("Returns the timing breakdown of the request")
+  {
+    TestHTTPSession::set_response_status(HTTPResponse::HTTP_OK);
+    TestHTTPSession::set_response("Test response");
+
+    auto const* uri = "http://server.com:80/test";
+    auto response = TesteeT::get(uri);
+
+    auto const& timings = response.timings();
+    REQUIRE(timings.bytes_received == 13);
+    REQUIRE_FALSE(timings.connection_reused);
+    REQUIRE(timings.total >= timings.checkout + timings.send_request + timings.time_to_first_byte);
+    REQUIRE(timings.total >= timings.body_transfer);
+  }
+
+  SECTION("Counts the bytes received by a streamed get")
+  {
+    TestHTTPSession::set_response_status(HTTPResponse::HTTP_OK);
+    TestHTTPSession::set_response("Test response");
+
+    auto const* uri = "http://server.com:80/test";
+    auto response = TesteeT::get_streamed(uri, [](std::istream& body) {
+      std::string first_word;
+      body >> first_word;
+    });
+
+    REQUIRE(response.timings().bytes_received == 13);
+  }
+
+  SECTION("Reports a reused connection")
+  {
+    TestHTTPSession::set_keep_alive(true);
+    TestHTTPSession::set_response("Test");
+
+    auto const* uri = "http://server.com:80/test";
+    auto first_response = TesteeT::get(uri);
+    TestHTTPSession::set_response("Test");
+    auto second_response = TesteeT::get(uri);
+
+    REQUIRE_FALSE(first_response.timings().connection_reused);
+    REQUIRE(second_response.timings().connection_reused);
+
+    TestHTTPSession::set_keep_alive(false);
+    TesteeT::session_pool().clear();
+  }
+
+  SECTION("Reports a connection of a reused session which reconnected as not reused")
+  {
+    TestHTTPSession::set_keep_alive(true);
+    TestHTTPSession::set_response("Test");
+
+    auto const* uri = "http://server.com:80/test";
+    auto first_response = TesteeT::get(uri);
+    auto const sessions_after_first_get = TestHTTPSession::created_sessions_;
+    TestHTTPSession::reconnect_ = true;
+    TestHTTPSession::set_response("Test");
+    auto second_response = TesteeT::get(uri);
+
+    REQUIRE(TestHTTPSession::created_sessions_ == sessions_after_first_get);
+    REQUIRE_FALSE(second_response.timings().connection_reused);
+
+    TestHTTPSession::reconnect_ = false;
+    TestHTTPSession::set_keep_alive(false);
+    TesteeT::session_pool().clear();
+  }
+
+  SECTION("Passes the timings to the timing sink")
+  {
+    TestHTTPSession::set_response("Test");
+    std::string reported_url{};
+    std::size_t reported_bytes{0};
+    coronan::set_http_timing_sink([&](std::string const& url, coronan::HTTPTimings const& timings) {
+      reported_url = url;
+      reported_bytes = timings.bytes_received;
+    });
+
+    auto const* uri = "http://server.com:80/test";
+    auto response = TesteeT::get(uri);
+    coronan::set_http_timing_sink({});
+
+    REQUIRE(reported_url == uri);
+    REQUIRE(reported_bytes == 4);
+  }
+
   SECTION("Throws an HTTPClientException when Session throws exception")
   {
     TestHTTPSession::set_throw_exception();
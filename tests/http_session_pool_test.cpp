@@ -0,0 +1,173 @@
+#include "coronan/http_session_pool.hpp"
+
+#include <catch2/catch.hpp>
+#include <chrono>
+#include <functional>
+#include <future>
+#include <memory>
+#include <string>
+
+namespace {
+
+struct TestSession
+{
+  TestSession(std::string const& session_host, std::uint16_t session_port) : host{session_host}, port{session_port}
+  {
+    ++created_sessions;
+  }
+
+  std::string host{};
+  std::uint16_t port{};
+  inline static int created_sessions{0};
+};
+
+struct TestClock
+{
+  using duration = std::chrono::milliseconds;
+  using rep = duration::rep;
+  using period = duration::period;
+  using time_point = std::chrono::time_point<TestClock>;
+  static constexpr bool is_steady = true;
+
+  static time_point now() noexcept
+  {
+    return current_time;
+  }
+
+  inline static time_point current_time{};
+};
+
+using TesteeT = coronan::HTTPSessionPool<TestSession, TestClock>;
+
+TEST_CASE("HTTPSessionPool checkout", "[HTTPSessionPool]")
+{
+  TestSession::created_sessions = 0;
+  auto testee = TesteeT{coronan::HTTPSessionPoolConfig{std::chrono::seconds{8}, 2}};
+
+  SECTION("creates a session for host and port")
+  {
+    auto lease = testee.checkout("server.com", 443);
+
+    REQUIRE(lease.session().host == "server.com");
+    REQUIRE(lease.session().port == 443);
+    REQUIRE_FALSE(lease.reused());
+    REQUIRE(TestSession::created_sessions == 1);
+  }
+
+  SECTION("reuses a session which was kept alive")
+  {
+    auto const* first_session = std::invoke([&testee]() {
+      auto lease = testee.checkout("server.com", 443);
+      lease.keep_alive();
+      return &lease.session();
+    });
+    REQUIRE(testee.idle_sessions("server.com", 443) == 1);
+
+    auto lease = testee.checkout("server.com", 443);
+
+    REQUIRE(&lease.session() == first_session);
+    REQUIRE(lease.reused());
+    REQUIRE(TestSession::created_sessions == 1);
+    REQUIRE(testee.idle_sessions("server.com", 443) == 0);
+  }
+
+  SECTION("discards a session which was not kept alive")
+  {
+    {
+      auto lease = testee.checkout("server.com", 443);
+    }
+    REQUIRE(testee.idle_sessions("server.com", 443) == 0);
+
+    auto lease = testee.checkout("server.com", 443);
+
+    REQUIRE(TestSession::created_sessions == 2);
+  }
+
+  SECTION("does not share sessions between hosts")
+  {
+    {
+      auto lease = testee.checkout("server.com", 443);
+      lease.keep_alive();
+    }
+
+    auto lease = testee.checkout("other.com", 443);
+
+    REQUIRE(lease.session().host == "other.com");
+    REQUIRE(TestSession::created_sessions == 2);
+    REQUIRE(testee.idle_sessions("server.com", 443) == 1);
+  }
+
+  SECTION("drops idle sessions after the idle timeout")
+  {
+    {
+      auto lease = testee.checkout("server.com", 443);
+      lease.keep_alive();
+    }
+    TestClock::current_time += std::chrono::seconds{9};
+
+    auto lease = testee.checkout("server.com", 443);
+
+    REQUIRE(TestSession::created_sessions == 2);
+    REQUIRE(testee.idle_sessions("server.com", 443) == 0);
+  }
+
+  SECTION("blocks when the maximum number of sessions per host is checked out")
+  {
+    auto first_lease = std::make_unique<TesteeT::Lease>(testee.checkout("server.com", 443));
+    auto second_lease = testee.checkout("server.com", 443);
+
+    auto third_checkout = std::async(std::launch::async, [&testee]() {
+      auto lease = testee.checkout("server.com", 443);
+      return lease.session().host;
+    });
+    REQUIRE(third_checkout.wait_for(std::chrono::milliseconds{50}) == std::future_status::timeout);
+
+    first_lease->keep_alive();
+    first_lease.reset();
+
+    REQUIRE(third_checkout.get() == "server.com");
+    REQUIRE(TestSession::created_sessions == 2);
+  }
+
+  SECTION("checkout_new creates a new session although an idle session exists")
+  {
+    {
+      auto lease = testee.checkout("server.com", 443);
+      lease.keep_alive();
+    }
+
+    auto lease = testee.checkout_new("server.com", 443);
+
+    REQUIRE_FALSE(lease.reused());
+    REQUIRE(TestSession::created_sessions == 2);
+    REQUIRE(testee.idle_sessions("server.com", 443) == 1);
+  }
+
+  SECTION("checkout_new discards an idle session when the maximum number of sessions per host exists")
+  {
+    auto first_lease = testee.checkout("server.com", 443);
+    {
+      auto lease = testee.checkout("server.com", 443);
+      lease.keep_alive();
+    }
+
+    auto lease = testee.checkout_new("server.com", 443);
+
+    REQUIRE(TestSession::created_sessions == 3);
+    REQUIRE(testee.idle_sessions("server.com", 443) == 0);
+  }
+
+  SECTION("clear discards all idle sessions")
+  {
+    {
+      auto lease = testee.checkout("server.com", 443);
+      lease.keep_alive();
+    }
+
+    testee.clear();
+
+    REQUIRE(testee.idle_sessions("server.com", 443) == 0);
+  }
+}
+
+} // namespace
@@ -0,0 +1,118 @@
+#include "coronan/http_timing.hpp"
+
+#include <catch2/catch.hpp>
+#include <chrono>
+
+namespace {
+
+using namespace std::chrono_literals;
+using coronan::HTTPPhase;
+
+TEST_CASE("LatencyHistogram", "[LatencyHistogram]")
+{
+  auto testee = coronan::LatencyHistogram{};
+
+  SECTION("returns 0 without recorded latencies")
+  {
+    REQUIRE(testee.count() == 0);
+    REQUIRE(testee.percentile(0.5) == 0ns);
+  }
+
+  SECTION("returns small latencies exactly")
+  {
+    testee.record(3ns);
+    testee.record(7ns);
+
+    REQUIRE(testee.percentile(0.5) == 3ns);
+    REQUIRE(testee.percentile(1.0) == 7ns);
+    REQUIRE(testee.count() == 2);
+  }
+
+  SECTION("returns percentiles within the relative error of the buckets")
+  {
+    for (int i = 1; i <= 1000; ++i)
+    {
+      testee.record(std::chrono::microseconds{i});
+    }
+
+    auto const p50 = std::chrono::duration<double, std::micro>{testee.percentile(0.5)}.count();
+    auto const p99 = std::chrono::duration<double, std::micro>{testee.percentile(0.99)}.count();
+    REQUIRE(p50 == Approx(500.0).epsilon(0.032));
+    REQUIRE(p99 == Approx(990.0).epsilon(0.032));
+    REQUIRE(testee.percentile(0.0) == testee.percentile(0.001));
+  }
+
+  SECTION("records very long latencies")
+  {
+    testee.record(std::chrono::hours{24 * 365});
+
+    auto const percentile = std::chrono::duration<double>{testee.percentile(1.0)}.count();
+    REQUIRE(percentile == Approx(365.0 * 24 * 3600).epsilon(0.032));
+  }
+
+  SECTION("records negative latencies as 0")
+  {
+    testee.record(-5ns);
+
+    REQUIRE(testee.percentile(1.0) == 0ns);
+  }
+}
+
+TEST_CASE("HTTPTimingHistograms", "[HTTPTimingHistograms]")
+{
+  auto testee = coronan::HTTPTimingHistograms{};
+
+  auto timings = coronan::HTTPTimings{};
+  timings.checkout = 1us;
+  timings.send_request = 20us;
+  timings.time_to_first_byte = 300us;
+  timings.body_transfer = 4000us;
+  timings.total = 4321us;
+  timings.bytes_received = 1024;
+
+  SECTION("records the latency of every phase")
+  {
+    testee.record(timings);
+    timings.connection_reused = true;
+    testee.record(timings);
+
+    REQUIRE(testee.count() == 2);
+    REQUIRE(testee.reused_connections() == 1);
+    REQUIRE(testee.bytes_received() == 2048);
+    REQUIRE(testee.percentile(HTTPPhase::checkout, 0.5) >= 1us);
+    REQUIRE(testee.percentile(HTTPPhase::checkout, 0.5) < 1032ns);
+    REQUIRE(testee.percentile(HTTPPhase::send_request, 0.5) >= 20us);
+    REQUIRE(testee.percentile(HTTPPhase::time_to_first_byte, 0.5) >= 300us);
+    REQUIRE(testee.percentile(HTTPPhase::body_transfer, 0.5) >= 4000us);
+    REQUIRE(testee.percentile(HTTPPhase::total, 0.99) >= 4321us);
+  }
+
+  SECTION("clear removes all recorded timings")
+  {
+    testee.record(timings);
+
+    testee.clear();
+
+    REQUIRE(testee.count() == 0);
+    REQUIRE(testee.bytes_received() == 0);
+    REQUIRE(testee.percentile(HTTPPhase::total, 0.5) == 0ns);
+  }
+}
+
+TEST_CASE("HTTP timing sink", "[HTTPTimingSink]")
+{
+  SECTION("report passes the timings to the sink")
+  {
+    auto histograms = coronan::HTTPTimingHistograms{};
+    coronan::set_http_timing_sink(
+        [&histograms](std::string const& /*url*/, coronan::HTTPTimings const& timings) { histograms.record(timings); });
+
+    coronan::report_http_timings("http://server.com/test", coronan::HTTPTimings{});
+    coronan::set_http_timing_sink({});
+    coronan::report_http_timings("http://server.com/test", coronan::HTTPTimings{});
+
+    REQUIRE(histograms.count() == 1);
+  }
+}
+
+} // namespace
@@ -0,0 +1,129 @@
+#include "coronan/iso_date.hpp"
+
+#include <catch2/catch.hpp>
+
+namespace {
+
+using namespace coronan::iso_date;
+
+TEST_CASE("iso_date parse_days", "[iso_date]")
+{
+  SECTION("parses a date")
+  {
+    REQUIRE(parse_days("1970-01-01") == 0);
+    REQUIRE(parse_days("2020-04-03") == 18355);
+    REQUIRE(parse_days("1969-12-31") == -1);
+  }
+
+  SECTION("parses the date of a date time")
+  {
+    REQUIRE(parse_days("2020-04-03T00:20:32.326Z") == 18355);
+  }
+
+  SECTION("parses leap days")
+  {
+    REQUIRE(parse_days("2020-02-29") == 18321);
+    REQUIRE(parse_days("2000-02-29").has_value());
+    REQUIRE_FALSE(parse_days("2021-02-29").has_value());
+    REQUIRE_FALSE(parse_days("1900-02-29").has_value());
+  }
+
+  SECTION("rejects invalid dates")
+  {
+    REQUIRE_FALSE(parse_days("").has_value());
+    REQUIRE_FALSE(parse_days("2020-4-3").has_value());
+    REQUIRE_FALSE(parse_days("2020/04/03").has_value());
+    REQUIRE_FALSE(parse_days("2020-13-01").has_value());
+    REQUIRE_FALSE(parse_days("2020-04-31").has_value());
+    REQUIRE_FALSE(parse_days("2020-04-00").has_value());
+    REQUIRE_FALSE(parse_days("20x0-04-03").has_value());
+  }
+
+  SECTION("is usable at compile time")
+  {
+    static_assert(parse_days("2020-04-03") == 18355);
+  }
+}
+
+TEST_CASE("iso_date parse_seconds", "[iso_date]")
+{
+  SECTION("parses a date time")
+  {
+    REQUIRE(parse_seconds("1970-01-01T00:00:00Z") == 0);
+    REQUIRE(parse_seconds("2020-04-03T00:20:32Z") == 1585873232);
+    REQUIRE(parse_seconds("1969-12-31T23:59:59Z") == -1);
+  }
+
+  SECTION("truncates fractional seconds")
+  {
+    REQUIRE(parse_seconds("2020-04-03T00:20:32.326Z") == 1585873232);
+    REQUIRE(parse_seconds("2020-04-01T19:58:34.000Z") == 1585771114);
+    REQUIRE(parse_seconds("2020-04-01T19:58:34.999999Z") == 1585771114);
+  }
+
+  SECTION("rejects invalid date times")
+  {
+    REQUIRE_FALSE(parse_seconds("").has_value());
+    REQUIRE_FALSE(parse_seconds("2020-04-03").has_value());
+    REQUIRE_FALSE(parse_seconds("2020-04-03T00:20:32").has_value());
+    REQUIRE_FALSE(parse_seconds("2020-04-03T00:20:32+01:00").has_value());
+    REQUIRE_FALSE(parse_seconds("2020-04-03 00:20:32Z").has_value());
+    REQUIRE_FALSE(parse_seconds("2020-04-03T24:00:00Z").has_value());
+    REQUIRE_FALSE(parse_seconds("2020-04-03T00:60:00Z").has_value());
+    REQUIRE_FALSE(parse_seconds("2020-04-03T00:20:32.Z").has_value());
+    REQUIRE_FALSE(parse_seconds("2020-04-03T00:20:32.3a6Z").has_value());
+    REQUIRE_FALSE(parse_seconds("2020-02-30T00:20:32Z").has_value());
+  }
+
+  SECTION("is usable at compile time")
+  {
+    static_assert(parse_seconds("2020-04-03T00:20:32.326Z") == 1585873232);
+  }
+}
+
+TEST_CASE("iso_date conversions", "[iso_date]")
+{
+  SECTION("civil_from_days is the inverse of days_from_civil")
+  {
+    for (int32_t days = -800'000; days <= 800'000; days += 997)
+    {
+      REQUIRE(days_from_civil(civil_from_days(days)) == days);
+    }
+  }
+
+  SECTION("formats days as date")
+  {
+    REQUIRE(format_days(0) == "1970-01-01");
+    REQUIRE(format_days(18355) == "2020-04-03");
+    REQUIRE(format_days(-1) == "1969-12-31");
+  }
+
+  SECTION("formats seconds as date time")
+  {
+    REQUIRE(format_seconds(0) == "1970-01-01T00:00:00Z");
+    REQUIRE(format_seconds(1585873232) == "2020-04-03T00:20:32Z");
+    REQUIRE(format_seconds(-1) == "1969-12-31T23:59:59Z");
+  }
+
+  SECTION("splits seconds into calendar date and time of day")
+  {
+    auto const date_time = civil_from_seconds(-1);
+
+    REQUIRE(date_time.date.year == 1969);
+    REQUIRE(date_time.date.month == 12);
+    REQUIRE(date_time.date.day == 31);
+    REQUIRE(date_time.hour == 23);
+    REQUIRE(date_time.minute == 59);
+    REQUIRE(date_time.second == 59);
+  }
+
+  SECTION("parse_seconds is the inverse of format_seconds")
+  {
+    for (int64_t seconds = -5'000'000'000; seconds <= 5'000'000'000; seconds += 9'999'991)
+    {
+      REQUIRE(parse_seconds(format_seconds(seconds)) == seconds);
+    }
+  }
+}
+
+} // namespace
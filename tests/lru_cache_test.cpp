@@ -0,0 +1,107 @@
+#include "coronan/lru_cache.hpp"
+
+#include <catch2/catch.hpp>
+#include <chrono>
+#include <string>
+
+namespace {
+
+struct TestClock
+{
+  using duration = std::chrono::milliseconds;
+  using rep = duration::rep;
+  using period = duration::period;
+  using time_point = std::chrono::time_point<TestClock>;
+  static constexpr bool is_steady = true;
+
+  static time_point now() noexcept
+  {
+    return current_time;
+  }
+
+  inline static time_point current_time{};
+};
+
+using TesteeT = coronan::LRUCache<std::string, int, TestClock>;
+
+TEST_CASE("LRUCache get and put", "[LRUCache]")
+{
+  auto testee = TesteeT{2, std::chrono::seconds{10}};
+
+  SECTION("returns nothing for an unknown key and counts a miss")
+  {
+    REQUIRE_FALSE(testee.get("a").has_value());
+    REQUIRE(testee.statistics().misses == 1);
+    REQUIRE(testee.statistics().hits == 0);
+  }
+
+  SECTION("returns a stored value and counts a hit")
+  {
+    testee.put("a", 1);
+
+    REQUIRE(testee.get("a") == 1);
+    REQUIRE(testee.statistics().hits == 1);
+    REQUIRE(testee.statistics().misses == 0);
+  }
+
+  SECTION("replaces the value of an existing key")
+  {
+    testee.put("a", 1);
+    testee.put("a", 2);
+
+    REQUIRE(testee.get("a") == 2);
+    REQUIRE(testee.size() == 1);
+  }
+
+  SECTION("evicts the least recently used entry if the capacity is exceeded")
+  {
+    testee.put("a", 1);
+    testee.put("b", 2);
+    REQUIRE(testee.get("a") == 1);
+
+    testee.put("c", 3);
+
+    REQUIRE(testee.size() == 2);
+    REQUIRE_FALSE(testee.get("b").has_value());
+    REQUIRE(testee.get("a") == 1);
+    REQUIRE(testee.get("c") == 3);
+    REQUIRE(testee.statistics().evictions == 1);
+  }
+
+  SECTION("expires entries after the time to live")
+  {
+    testee.put("a", 1);
+    TestClock::current_time += std::chrono::seconds{9};
+    REQUIRE(testee.get("a") == 1);
+
+    TestClock::current_time += std::chrono::seconds{1};
+
+    REQUIRE_FALSE(testee.get("a").has_value());
+    REQUIRE(testee.size() == 0);
+    REQUIRE(testee.statistics().expirations == 1);
+    REQUIRE(testee.statistics().misses == 1);
+  }
+
+  SECTION("clear removes all entries")
+  {
+    testee.put("a", 1);
+    testee.put("b", 2);
+
+    testee.clear();
+
+    REQUIRE(testee.size() == 0);
+    REQUIRE_FALSE(testee.get("a").has_value());
+  }
+}
+
+TEST_CASE("LRUCache without capacity does not store anything", "[LRUCache]")
+{
+  auto testee = TesteeT{0, std::chrono::seconds{10}};
+
+  testee.put("a", 1);
+
+  REQUIRE(testee.size() == 0);
+  REQUIRE_FALSE(testee.get("a").has_value());
+}
+
+} // namespace
@@ -0,0 +1,36 @@
+#include "coronan/ssl_client.hpp"
+
+#include <catch2/catch.hpp>
+#include <future>
+#include <vector>
+
+namespace {
+
+TEST_CASE("SSLClient shared instance", "[SSLClient]")
+{
+  SECTION("is the same instance for every call")
+  {
+    auto const& first_client = coronan::SSLClient::shared_with_accept_certificate_handler();
+    auto const& second_client = coronan::SSLClient::shared_with_accept_certificate_handler();
+
+    REQUIRE(&first_client == &second_client);
+  }
+
+  SECTION("is shared between threads")
+  {
+    auto const* const client = &coronan::SSLClient::shared_with_accept_certificate_handler();
+    std::vector<std::future<coronan::SSLClient*>> clients;
+    for (auto i = 0; i < 4; ++i)
+    {
+      clients.push_back(
+          std::async(std::launch::async, []() { return &coronan::SSLClient::shared_with_accept_certificate_handler(); }));
+    }
+
+    for (auto& other_client : clients)
+    {
+      REQUIRE(other_client.get() == client);
+    }
+  }
+}
+
+} // namespace
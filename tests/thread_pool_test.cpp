@@ -0,0 +1,89 @@
+#include "coronan/thread_pool.hpp"
+
+#include <atomic>
+#include <catch2/catch.hpp>
+#include <chrono>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+namespace {
+
+TEST_CASE("ThreadPool", "[ThreadPool]")
+{
+  SECTION("starts at least one worker thread")
+  {
+    coronan::ThreadPool const testee{0};
+
+    REQUIRE(testee.size() == 1);
+  }
+
+  SECTION("returns the task result through the future")
+  {
+    coronan::ThreadPool testee{2};
+
+    auto result = testee.submit([]() { return 42; });
+
+    REQUIRE(result.get() == 42);
+  }
+
+  SECTION("passes a task exception through the future")
+  {
+    coronan::ThreadPool testee{2};
+
+    auto result = testee.submit([]() -> int { throw std::runtime_error{"failed"}; });
+
+    REQUIRE_THROWS_AS(result.get(), std::runtime_error);
+  }
+
+  SECTION("runs at most thread_count tasks concurrently")
+  {
+    constexpr auto thread_count = 3;
+    std::atomic<int> running_tasks{0};
+    std::atomic<int> max_running_tasks{0};
+    {
+      coronan::ThreadPool testee{thread_count};
+      std::vector<std::future<void>> results;
+      for (auto i = 0; i < 12; ++i)
+      {
+        results.push_back(testee.submit([&running_tasks, &max_running_tasks]() {
+          auto const running = ++running_tasks;
+          auto max_running = max_running_tasks.load();
+          while (running > max_running && !max_running_tasks.compare_exchange_weak(max_running, running))
+          {
+          }
+          std::this_thread::sleep_for(std::chrono::milliseconds{5});
+          --running_tasks;
+        }));
+      }
+    }
+
+    REQUIRE(max_running_tasks <= thread_count);
+    REQUIRE(max_running_tasks > 1);
+  }
+
+  SECTION("finishes all submitted tasks before destruction")
+  {
+    std::atomic<int> finished_tasks{0};
+    {
+      coronan::ThreadPool testee{2};
+      for (auto i = 0; i < 10; ++i)
+      {
+        testee.submit([&finished_tasks]() { ++finished_tasks; });
+      }
+    }
+
+    REQUIRE(finished_tasks == 10);
+  }
+
+  SECTION("provides a process wide shared pool")
+  {
+    auto& testee = coronan::ThreadPool::shared();
+
+    REQUIRE(&testee == &coronan::ThreadPool::shared());
+    REQUIRE(testee.size() == coronan::ThreadPool::shared_thread_count);
+    REQUIRE(testee.submit([]() { return 42; }).get() == 42);
+  }
+}
+
+} // namespace
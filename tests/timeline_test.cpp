@@ -0,0 +1,88 @@
+#include "coronan/corona-api_datatypes.hpp"
+
+#include <catch2/catch.hpp>
+#include <cstdint>
+
+namespace {
+
+using Metric = coronan::Timeline::Metric;
+
+TEST_CASE("Timeline", "[Timeline]")
+{
+  auto testee = coronan::Timeline{};
+
+  SECTION("is empty without points")
+  {
+    REQUIRE(testee.empty());
+    REQUIRE(testee.size() == 0);
+    REQUIRE_FALSE(testee.max(Metric::confirmed).has_value());
+    REQUIRE(testee.sum(Metric::confirmed) == 0);
+  }
+
+  SECTION("appends points without values")
+  {
+    testee.push_back(18355);
+    testee.push_back(std::nullopt);
+
+    REQUIRE(testee.size() == 2);
+    REQUIRE(testee.date(0) == 18355);
+    REQUIRE_FALSE(testee.date(1).has_value());
+    REQUIRE_FALSE(testee.value(0, Metric::deaths).has_value());
+    REQUIRE(testee.count(Metric::deaths) == 0);
+  }
+
+  SECTION("returns the set values")
+  {
+    testee.push_back(18355);
+    testee.set(0, Metric::deaths, 536);
+    testee.set(0, Metric::new_recovered, 0);
+
+    REQUIRE(testee.value(0, Metric::deaths) == 536);
+    REQUIRE(testee.value(0, Metric::new_recovered) == 0U);
+    REQUIRE_FALSE(testee.value(0, Metric::confirmed).has_value());
+    REQUIRE(testee.values(Metric::deaths) == std::vector<uint32_t>{536});
+  }
+
+  SECTION("scans a metric over more points than a bitmap word")
+  {
+    constexpr uint32_t point_count = 200;
+    testee.reserve(point_count);
+    for (uint32_t i = 0; i < point_count; ++i)
+    {
+      testee.push_back(static_cast<int32_t>(i));
+      if (i % 2 == 0)
+      {
+        testee.set(i, Metric::confirmed, i);
+      }
+    }
+
+    REQUIRE(testee.size() == point_count);
+    REQUIRE(testee.count(Metric::confirmed) == 100);
+    REQUIRE(testee.max(Metric::confirmed) == 198U);
+    REQUIRE(testee.sum(Metric::confirmed) == 9900);
+    REQUIRE(testee.value(131, Metric::confirmed) == std::nullopt);
+    REQUIRE(testee.value(130, Metric::confirmed) == 130U);
+    REQUIRE(testee.epoch_days().back() == 199);
+  }
+
+  SECTION("returns the maximum of a metric whose values are all 0")
+  {
+    testee.push_back(18355);
+    testee.set(0, Metric::new_deaths, 0);
+
+    REQUIRE(testee.max(Metric::new_deaths) == 0U);
+  }
+
+  SECTION("clear removes all points")
+  {
+    testee.push_back(18355);
+    testee.set(0, Metric::deaths, 536);
+
+    testee.clear();
+
+    REQUIRE(testee.empty());
+    REQUIRE(testee.count(Metric::deaths) == 0);
+  }
+}
+
+} // namespace
@@ -0,0 +1,47 @@
+#include "coronan/tls_session_cache.hpp"
+
+#include <catch2/catch.hpp>
+
+namespace {
+
+TEST_CASE("TLSSessionCache", "[TLSSessionCache]")
+{
+  auto testee = coronan::TLSSessionCache{};
+
+  SECTION("returns no session for an unknown host")
+  {
+    REQUIRE_FALSE(testee.get("server.com", 443));
+  }
+
+  SECTION("returns the session of the latest handshake with a host")
+  {
+    auto const session = Poco::Net::Session::Ptr{new Poco::Net::Session{nullptr}};
+    testee.handshake_completed("server.com", 443, session, false);
+
+    REQUIRE(testee.get("server.com", 443) == session);
+    REQUIRE_FALSE(testee.get("server.com", 8443));
+    REQUIRE_FALSE(testee.get("other.com", 443));
+  }
+
+  SECTION("counts full and resumed handshakes")
+  {
+    testee.handshake_completed("server.com", 443, Poco::Net::Session::Ptr{}, false);
+    testee.handshake_completed("server.com", 443, Poco::Net::Session::Ptr{}, true);
+    testee.handshake_completed("server.com", 443, Poco::Net::Session::Ptr{}, true);
+
+    REQUIRE(testee.statistics().full_handshakes == 1);
+    REQUIRE(testee.statistics().resumed_handshakes == 2);
+  }
+
+  SECTION("clear discards the cached sessions")
+  {
+    testee.handshake_completed("server.com", 443, Poco::Net::Session::Ptr{new Poco::Net::Session{nullptr}}, false);
+
+    testee.clear();
+
+    REQUIRE_FALSE(testee.get("server.com", 443));
+    REQUIRE(testee.statistics().full_handshakes == 1);
+  }
+}
+
+} // namespace